@@ -0,0 +1,241 @@
+#pragma once
+
+#include "Deciders.h"
+
+#include <map>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <unordered_set>
+
+/**
+ * Частичная конфигурация: состояние и известные ячейки ленты
+ * относительно головки (головка всегда в позиции 0). Остальные ячейки неизвестны
+ */
+struct PartialConfiguration {
+    int state = 0;
+    std::map<int, int> cells;
+
+    /**
+     * Ключ для мемоизации
+     */
+    std::string GetKey() const {
+        std::string key = std::to_string(state);
+        for (const auto& [position, symbol] : cells) {
+            key += ':' + std::to_string(position) + '=' + std::to_string(symbol);
+        }
+        return key;
+    }
+
+    /**
+     * Может ли конфигурация совпасть со стартовой (состояние 0, пустая лента)
+     */
+    bool MatchesInitial() const {
+        if (state != 0) return false;
+        for (const auto& [position, symbol] : cells) {
+            if (symbol != 0) return false;
+        }
+        return true;
+    }
+};
+
+/**
+ * Сертификат незавершаемости
+ * Множество частичных конфигураций, содержащее все останавливающие
+ * конфигурации и замкнутое относительно предшественников; ни одна из них
+ * не совпадает со стартовой, значит остановка недостижима
+ */
+struct BackwardCertificate {
+    size_t machine_id = 0;
+    size_t depth = 0;   // Глубина, на которой все ветви погибли
+    std::vector<PartialConfiguration> configurations;
+};
+
+/**
+ * Результат обратного анализа одной машины
+ */
+struct BackwardResult {
+    size_t machine_id = 0;
+    DeciderVerdict verdict = DeciderVerdict::UNDECIDED;
+    size_t explored = 0;   // Сколько частичных конфигураций рассмотрено
+    BackwardCertificate certificate;
+};
+
+/**
+ * Обратный анализатор незавершаемости
+ * Ответственность: поиск назад от каждого неопределённого перехода (s, a)
+ * по частичным конфигурациям. Если до max_depth все ветви погибают
+ * (противоречие с записанным символом), машина никогда не останавливается
+ */
+class BackwardReasoningAnalyzer {
+private:
+    size_t max_depth_;
+    size_t max_configurations_;
+
+    /**
+     * Все непротиворечивые предшественники частичной конфигурации
+     */
+    static std::vector<PartialConfiguration> Predecessors(const CandidateMachine& machine,
+                                                          const PartialConfiguration& config) {
+        std::vector<PartialConfiguration> result;
+        for (int state = 0; state < machine.states_count; ++state) {
+            for (int symbol = 0; symbol < machine.symbols_count; ++symbol) {
+                const auto& entry = machine.GetEntry(state, symbol);
+                if (!entry.defined || entry.to_state != config.state) continue;
+
+                // До шага головка стояла в -d и записала туда write_symbol
+                int shift = static_cast<int>(entry.direction);
+                int previous = -shift;
+                auto it = config.cells.find(previous);
+                if (it != config.cells.end() && it->second != entry.write_symbol) {
+                    continue;   // Ветвь погибла
+                }
+
+                PartialConfiguration predecessor;
+                predecessor.state = state;
+                for (const auto& [position, cell] : config.cells) {
+                    predecessor.cells[position + shift] = cell;
+                }
+                predecessor.cells[0] = symbol;
+                result.push_back(std::move(predecessor));
+            }
+        }
+        return result;
+    }
+
+public:
+    explicit BackwardReasoningAnalyzer(size_t max_depth = 30, size_t max_configurations = 100000)
+        : max_depth_(max_depth), max_configurations_(max_configurations) {}
+
+    /**
+     * Проанализировать одну машину
+     */
+    BackwardResult Analyze(const CandidateMachine& machine) const {
+        BackwardResult result;
+        result.machine_id = machine.id;
+
+        std::unordered_set<std::string> seen;
+        std::vector<PartialConfiguration> explored;
+        std::vector<PartialConfiguration> frontier;
+
+        // Стартуем от каждого неопределённого перехода
+        for (int state = 0; state < machine.states_count; ++state) {
+            for (int symbol = 0; symbol < machine.symbols_count; ++symbol) {
+                if (machine.GetEntry(state, symbol).defined) continue;
+                PartialConfiguration halting;
+                halting.state = state;
+                halting.cells[0] = symbol;
+                if (seen.insert(halting.GetKey()).second) {
+                    frontier.push_back(std::move(halting));
+                }
+            }
+        }
+
+        for (size_t depth = 0; depth <= max_depth_; ++depth) {
+            if (frontier.empty()) {
+                result.verdict = DeciderVerdict::NON_HALTING;
+                result.certificate.machine_id = machine.id;
+                result.certificate.depth = depth;
+                result.certificate.configurations = std::move(explored);
+                return result;
+            }
+            if (depth == max_depth_) break;
+
+            std::vector<PartialConfiguration> next;
+            for (auto& config : frontier) {
+                if (config.MatchesInitial()) {
+                    // Стартовая конфигурация может вести к остановке
+                    result.explored = seen.size();
+                    return result;
+                }
+                for (auto& predecessor : Predecessors(machine, config)) {
+                    if (seen.insert(predecessor.GetKey()).second) {
+                        next.push_back(std::move(predecessor));
+                    }
+                }
+                explored.push_back(std::move(config));
+            }
+
+            if (seen.size() > max_configurations_) break;
+            frontier = std::move(next);
+        }
+
+        result.explored = seen.size();
+        return result;
+    }
+
+    /**
+     * Вердикт для конвейера децайдеров
+     */
+    DeciderVerdict Decide(const CandidateMachine& machine) const {
+        return Analyze(machine).verdict;
+    }
+
+    /**
+     * Проанализировать набор машин на нескольких потоках
+     * @return Результаты в порядке входного массива
+     */
+    std::vector<BackwardResult> AnalyzeAll(const std::vector<CandidateMachine>& machines,
+                                           size_t threads_count = std::thread::hardware_concurrency()) const {
+        std::vector<BackwardResult> results(machines.size());
+        std::atomic<size_t> next_index{0};
+        threads_count = std::max<size_t>(1, threads_count);
+
+        auto worker = [&]() {
+            size_t index;
+            while ((index = next_index.fetch_add(1, std::memory_order_relaxed)) < machines.size()) {
+                results[index] = Analyze(machines[index]);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < threads_count; ++t) {
+            threads.emplace_back(worker);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        return results;
+    }
+
+    /**
+     * Проанализировать правила TransitionManager (состояния 0..n-1, символы 0..k-1)
+     */
+    BackwardResult Analyze(const TransitionManager<int, int>& manager, int states_count, int symbols_count) const {
+        MachineEnumerator enumerator(states_count, symbols_count);
+        CandidateMachine machine{0, states_count, symbols_count, enumerator.FromTransitionManager(manager)};
+        return Analyze(machine);
+    }
+
+    /**
+     * Независимая проверка сертификата
+     */
+    static bool VerifyCertificate(const CandidateMachine& machine, const BackwardCertificate& certificate) {
+        std::unordered_set<std::string> members;
+        for (const auto& config : certificate.configurations) {
+            if (config.MatchesInitial()) return false;
+            members.insert(config.GetKey());
+        }
+
+        // Все останавливающие конфигурации входят в множество
+        for (int state = 0; state < machine.states_count; ++state) {
+            for (int symbol = 0; symbol < machine.symbols_count; ++symbol) {
+                if (machine.GetEntry(state, symbol).defined) continue;
+                PartialConfiguration halting;
+                halting.state = state;
+                halting.cells[0] = symbol;
+                if (members.find(halting.GetKey()) == members.end()) return false;
+            }
+        }
+
+        // Множество замкнуто относительно предшественников
+        for (const auto& config : certificate.configurations) {
+            for (const auto& predecessor : Predecessors(machine, config)) {
+                if (members.find(predecessor.GetKey()) == members.end()) return false;
+            }
+        }
+        return true;
+    }
+};
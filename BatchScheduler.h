@@ -0,0 +1,603 @@
+#pragma once
+
+#include "ExecutionEngines.h"
+#include "Histogram.h"
+#include "ConcurrentQueue.h"
+
+#include <map>
+#include <deque>
+#include <queue>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <stdexcept>
+#include <condition_variable>
+
+/**
+ * Квант выполнения задания, ожидающий в очереди планировщика
+ */
+struct SchedulingTicket {
+    size_t job_index = 0;
+    int priority = 0;           // Больше - важнее
+    double deadline = 0.0;      // Секунды от начала пакета
+    std::string group;          // Группа (арендатор) для справедливого разделения
+    size_t sequence = 0;        // Порядок постановки в очередь (FIFO при равенстве)
+};
+
+/**
+ * Интерфейс политики планирования
+ * Вызовы сериализуются исполнителем, синхронизация внутри не нужна
+ */
+class ISchedulingPolicy {
+public:
+    virtual ~ISchedulingPolicy() = default;
+
+    virtual std::string GetName() const = 0;
+    virtual void Push(const SchedulingTicket& ticket) = 0;
+    virtual bool Pop(SchedulingTicket& ticket) = 0;
+    virtual bool IsEmpty() const = 0;
+
+    /**
+     * Уведомление о выполненном кванте (для учёта потреблённых шагов)
+     */
+    virtual void OnSliceCompleted(const SchedulingTicket&, size_t) {}
+};
+
+/**
+ * Строгий приоритет: всегда квант с наибольшим приоритетом
+ */
+class PrioritySchedulingPolicy : public ISchedulingPolicy {
+private:
+    struct Compare {
+        bool operator()(const SchedulingTicket& a, const SchedulingTicket& b) const {
+            if (a.priority != b.priority) return a.priority < b.priority;
+            return a.sequence > b.sequence;
+        }
+    };
+    std::priority_queue<SchedulingTicket, std::vector<SchedulingTicket>, Compare> queue_;
+
+public:
+    std::string GetName() const override { return "priority"; }
+
+    void Push(const SchedulingTicket& ticket) override { queue_.push(ticket); }
+
+    bool Pop(SchedulingTicket& ticket) override {
+        if (queue_.empty()) return false;
+        ticket = queue_.top();
+        queue_.pop();
+        return true;
+    }
+
+    bool IsEmpty() const override { return queue_.empty(); }
+};
+
+/**
+ * Earliest deadline first: квант задания с ближайшим сроком
+ */
+class EarliestDeadlinePolicy : public ISchedulingPolicy {
+private:
+    struct Compare {
+        bool operator()(const SchedulingTicket& a, const SchedulingTicket& b) const {
+            if (a.deadline != b.deadline) return a.deadline > b.deadline;
+            return a.sequence > b.sequence;
+        }
+    };
+    std::priority_queue<SchedulingTicket, std::vector<SchedulingTicket>, Compare> queue_;
+
+public:
+    std::string GetName() const override { return "edf"; }
+
+    void Push(const SchedulingTicket& ticket) override { queue_.push(ticket); }
+
+    bool Pop(SchedulingTicket& ticket) override {
+        if (queue_.empty()) return false;
+        ticket = queue_.top();
+        queue_.pop();
+        return true;
+    }
+
+    bool IsEmpty() const override { return queue_.empty(); }
+};
+
+/**
+ * Взвешенное справедливое разделение между группами
+ * Каждая группа копит виртуальное время = потреблённые шаги / вес;
+ * следующий квант получает активная группа с наименьшим виртуальным временем
+ */
+class FairSharePolicy : public ISchedulingPolicy {
+private:
+    struct Group {
+        std::deque<SchedulingTicket> queue;
+        double weight = 1.0;
+        double virtual_time = 0.0;
+    };
+    std::map<std::string, Group> groups_;
+    size_t queued_ = 0;
+
+    double MinActiveVirtualTime() const {
+        double result = std::numeric_limits<double>::infinity();
+        for (const auto& [name, group] : groups_) {
+            if (!group.queue.empty()) result = std::min(result, group.virtual_time);
+        }
+        return result;
+    }
+
+public:
+    std::string GetName() const override { return "fair-share"; }
+
+    /**
+     * Задать вес группы (по умолчанию 1)
+     */
+    void SetWeight(const std::string& group, double weight) {
+        if (weight <= 0.0) {
+            throw std::invalid_argument("Вес группы должен быть положительным");
+        }
+        groups_[group].weight = weight;
+    }
+
+    void Push(const SchedulingTicket& ticket) override {
+        Group& group = groups_[ticket.group];
+        if (group.queue.empty()) {
+            // Простаивавшая группа не получает накопленного преимущества
+            double floor = MinActiveVirtualTime();
+            if (floor != std::numeric_limits<double>::infinity()) {
+                group.virtual_time = std::max(group.virtual_time, floor);
+            }
+        }
+        group.queue.push_back(ticket);
+        queued_++;
+    }
+
+    bool Pop(SchedulingTicket& ticket) override {
+        Group* best = nullptr;
+        for (auto& [name, group] : groups_) {
+            if (!group.queue.empty() && (!best || group.virtual_time < best->virtual_time)) {
+                best = &group;
+            }
+        }
+        if (!best) return false;
+        ticket = best->queue.front();
+        best->queue.pop_front();
+        queued_--;
+        return true;
+    }
+
+    bool IsEmpty() const override { return queued_ == 0; }
+
+    void OnSliceCompleted(const SchedulingTicket& ticket, size_t steps) override {
+        Group& group = groups_[ticket.group];
+        group.virtual_time += static_cast<double>(steps) / group.weight;
+    }
+};
+
+/**
+ * Задание пакетного исполнителя
+ */
+template <typename State, typename Symbol>
+struct ScheduledJob {
+    MachineDefinition<State, Symbol> machine;
+    std::vector<Symbol> input;
+    size_t max_steps = 100000;
+    int priority = 0;
+    double deadline = std::numeric_limits<double>::infinity();   // Секунды от начала пакета
+    std::string group = "default";
+};
+
+/**
+ * Отчёт по одному заданию
+ */
+struct ScheduledJobReport {
+    ExecutionResult result = ExecutionResult::ERROR;
+    size_t steps = 0;
+    size_t slices = 0;
+    double latency_seconds = 0.0;   // От начала пакета до завершения задания
+    double execution_seconds = 0.0; // Суммарное время квантов задания
+    double cpu_seconds = 0.0;       // Суммарное процессорное время квантов
+    size_t peak_memory_bytes = 0;   // Пиковый объём ленты
+    uint64_t allocations = 0;       // Выделений памяти (если подключён AllocationCounter)
+    bool deadline_met = true;
+};
+
+/**
+ * Метрики пакета для одной политики
+ */
+struct SchedulingMetrics {
+    std::string policy;
+    size_t jobs = 0;
+    size_t total_steps = 0;
+    size_t deadline_misses = 0;
+    double wall_seconds = 0.0;
+    double cpu_seconds = 0.0;       // Процессорное время всех заданий
+    size_t peak_memory_bytes = 0;   // Наибольший пик памяти среди заданий
+    uint64_t allocations = 0;
+    double mean_latency = 0.0;
+    double p95_latency = 0.0;
+    double max_latency = 0.0;
+    std::map<std::string, double> group_mean_latency;
+    HdrHistogram execution_time_us;   // Время выполнения заданий, мкс
+    HdrHistogram steps;               // Шагов на задание
+
+    double GetJobsThroughput() const {
+        return wall_seconds > 0.0 ? static_cast<double>(jobs) / wall_seconds : 0.0;
+    }
+
+    double GetStepsThroughput() const {
+        return wall_seconds > 0.0 ? static_cast<double>(total_steps) / wall_seconds : 0.0;
+    }
+};
+
+/**
+ * Параллельный пакетный исполнитель с квантованием
+ * Ответственность: выполнение заданий квантами по slice_steps шагов
+ * (Run, затем Resume) на пуле потоков; порядок квантов задаёт политика
+ */
+template <typename State, typename Symbol>
+class ParallelBatchExecutor {
+private:
+    size_t threads_count_;
+    size_t slice_steps_;
+    std::unique_ptr<ISchedulingPolicy> policy_;
+    SchedulingMetrics metrics_;
+
+    void CollectMetrics(const std::vector<ScheduledJob<State, Symbol>>& jobs,
+                        const std::vector<ScheduledJobReport>& reports,
+                        double wall_seconds,
+                        const ConcurrentHistogram& execution_time_us,
+                        const ConcurrentHistogram& steps) {
+        metrics_ = SchedulingMetrics{};
+        metrics_.policy = policy_->GetName();
+        metrics_.execution_time_us = execution_time_us.Snapshot();
+        metrics_.steps = steps.Snapshot();
+        metrics_.jobs = reports.size();
+        metrics_.wall_seconds = wall_seconds;
+        if (reports.empty()) return;
+
+        std::vector<double> latencies;
+        std::map<std::string, std::pair<double, size_t>> groups;
+        for (size_t i = 0; i < reports.size(); ++i) {
+            metrics_.total_steps += reports[i].steps;
+            metrics_.cpu_seconds += reports[i].cpu_seconds;
+            metrics_.peak_memory_bytes = std::max(metrics_.peak_memory_bytes, reports[i].peak_memory_bytes);
+            metrics_.allocations += reports[i].allocations;
+            if (!reports[i].deadline_met) metrics_.deadline_misses++;
+            latencies.push_back(reports[i].latency_seconds);
+            auto& group = groups[jobs[i].group];
+            group.first += reports[i].latency_seconds;
+            group.second++;
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        double sum = 0.0;
+        for (double latency : latencies) sum += latency;
+        metrics_.mean_latency = sum / static_cast<double>(latencies.size());
+        metrics_.p95_latency = latencies[std::min(latencies.size() - 1, latencies.size() * 95 / 100)];
+        metrics_.max_latency = latencies.back();
+        for (const auto& [name, group] : groups) {
+            metrics_.group_mean_latency[name] = group.first / static_cast<double>(group.second);
+        }
+    }
+
+public:
+    /**
+     * @param threads_count Число рабочих потоков
+     * @param slice_steps Шагов в одном кванте
+     * @param policy Политика планирования
+     */
+    ParallelBatchExecutor(size_t threads_count, size_t slice_steps, std::unique_ptr<ISchedulingPolicy> policy)
+        : threads_count_(std::max<size_t>(1, threads_count)),
+          slice_steps_(std::max<size_t>(1, slice_steps)),
+          policy_(std::move(policy)) {
+        if (!policy_) {
+            throw std::invalid_argument("Не задана политика планирования");
+        }
+    }
+
+    ISchedulingPolicy& GetPolicy() {
+        return *policy_;
+    }
+
+    /**
+     * Выполнить пакет
+     * @return Отчёты в порядке заданий
+     */
+    std::vector<ScheduledJobReport> Run(const std::vector<ScheduledJob<State, Symbol>>& jobs) {
+        std::vector<ScheduledJobReport> reports(jobs.size());
+        std::vector<UniquePtr<TuringMachine<State, Symbol>>> machines(jobs.size());
+
+        std::mutex mutex;
+        std::condition_variable ready;
+        size_t remaining = jobs.size();
+        size_t sequence = 0;
+
+        // Каждый поток пишет в свои счётчики без блокировок
+        ConcurrentHistogram execution_histogram;
+        ConcurrentHistogram steps_histogram;
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            policy_->Push({i, jobs[i].priority, jobs[i].deadline, jobs[i].group, sequence++});
+        }
+
+        auto worker = [&]() {
+            if (Tracer::IsEnabled()) {
+                Tracer::Instance().SetThreadName("batch worker");
+            }
+            auto& execution_recorder = execution_histogram.AcquireRecorder();
+            auto& steps_recorder = steps_histogram.AcquireRecorder();
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                SchedulingTicket ticket;
+                {
+                    TraceSpan wait_span("batch", "wait");
+                    ready.wait(lock, [&]() { return remaining == 0 || !policy_->IsEmpty(); });
+                    if (remaining == 0) return;
+                    policy_->Pop(ticket);
+                }
+                lock.unlock();
+
+                // Задание находится в очереди не более одного раза, поэтому
+                // его машиной в каждый момент владеет только этот поток
+                const auto& job = jobs[ticket.job_index];
+                auto& machine = machines[ticket.job_index];
+                auto& report = reports[ticket.job_index];
+                size_t before = 0;
+                ExecutionResult result;
+                auto slice_start = std::chrono::steady_clock::now();
+                {
+                    TraceSpan slice_span("batch", "slice");
+                    slice_span.SetArg("job", static_cast<long long>(ticket.job_index));
+                    if (report.slices == 0) {
+                        machine = job.machine.Instantiate(job.input);
+                        result = machine->Run(std::min(slice_steps_, job.max_steps));
+                    } else {
+                        before = machine->GetStepCount();
+                        result = machine->Resume(std::min(before + slice_steps_, job.max_steps));
+                    }
+                }
+                size_t steps = machine->GetStepCount();
+                report.execution_seconds += std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - slice_start).count();
+                const StatisticsManager& statistics = machine->GetStatisticsManager();
+                report.cpu_seconds += static_cast<double>(statistics.GetCpuTimeMicros().count()) / 1e6;
+                report.allocations += statistics.GetAllocationsCount();
+                report.peak_memory_bytes = std::max(report.peak_memory_bytes, statistics.GetPeakMemoryBytes());
+
+                bool finished = !(result == ExecutionResult::TIMEOUT && steps < job.max_steps);
+                if (finished) {
+                    TraceSpan record_span("batch", "record metrics");
+                    execution_recorder.Record(static_cast<uint64_t>(report.execution_seconds * 1e6));
+                    steps_recorder.Record(steps);
+                }
+
+                TraceSpan write_span("batch", finished ? "write result" : "requeue");
+                lock.lock();
+                policy_->OnSliceCompleted(ticket, steps - before);
+                report.slices++;
+
+                if (!finished) {
+                    ticket.sequence = sequence++;
+                    policy_->Push(ticket);
+                    ready.notify_one();
+                    continue;
+                }
+
+                report.result = result;
+                report.steps = steps;
+                report.latency_seconds = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start).count();
+                report.deadline_met = report.latency_seconds <= job.deadline;
+                if (--remaining == 0) {
+                    ready.notify_all();
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < threads_count_; ++t) {
+            threads.emplace_back(worker);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        CollectMetrics(jobs, reports,
+                       std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+                       execution_histogram, steps_histogram);
+        return reports;
+    }
+
+    /**
+     * Метрики последнего пакета
+     */
+    const SchedulingMetrics& GetMetrics() const {
+        return metrics_;
+    }
+
+    /**
+     * Вывести метрики пакета
+     */
+    void PrintMetrics(std::ostream& out = std::cout) const {
+        out << std::left << std::setw(12) << metrics_.policy
+            << " заданий/с: " << std::fixed << std::setprecision(0) << metrics_.GetJobsThroughput()
+            << ", шагов/с: " << metrics_.GetStepsThroughput()
+            << std::setprecision(4)
+            << ", задержка ср./p95/макс. (с): " << metrics_.mean_latency
+            << " / " << metrics_.p95_latency << " / " << metrics_.max_latency
+            << ", пропущено сроков: " << metrics_.deadline_misses << std::endl;
+        for (const auto& [group, latency] : metrics_.group_mean_latency) {
+            out << "    группа " << std::setw(12) << group << " средняя задержка: " << latency << " с" << std::endl;
+        }
+        out << "    процессорное время: " << metrics_.cpu_seconds << " с (загрузка "
+            << std::setprecision(1) << 100.0 * metrics_.cpu_seconds / std::max(metrics_.wall_seconds, 1e-9)
+            << "%), пик памяти задания: " << metrics_.peak_memory_bytes << " байт";
+        if (AllocationCounter::IsInstalled()) {
+            out << ", выделений: " << metrics_.allocations;
+        }
+        out << std::endl;
+        out << std::defaultfloat;
+        out << "    время выполнения: ";
+        metrics_.execution_time_us.PrintSummary(out, "мкс");
+        out << "    шагов на задание: ";
+        metrics_.steps.PrintSummary(out);
+    }
+};
+
+/**
+ * Задание потокового исполнителя
+ */
+template <typename State, typename Symbol>
+struct StreamJob {
+    size_t id = 0;
+    MachineDefinition<State, Symbol> machine;
+    std::vector<Symbol> input;
+    size_t max_steps = 100000;
+};
+
+/**
+ * Результат задания потокового исполнителя
+ */
+template <typename State, typename Symbol>
+struct StreamJobResult {
+    size_t id = 0;
+    EngineOutcome<State, Symbol> outcome;
+    double execution_seconds = 0.0;
+};
+
+/**
+ * Потоковый исполнитель заданий
+ * Ответственность: приём заданий от нескольких производителей, исполнение
+ * на пуле потоков и выдача результатов нескольким потребителям. Приём и
+ * выдача - ограниченные lock-free очереди BoundedMPMCQueue: когда очередь
+ * заполнена, Submit и рабочие потоки ждут (обратное давление), поэтому
+ * память ограничена ёмкостями очередей при любой скорости потребителей.
+ * Результаты выдаются в порядке завершения, не в порядке поступления.
+ * Движок вызывается из нескольких потоков одновременно
+ */
+template <typename State, typename Symbol>
+class StreamingBatchRunner {
+public:
+    using Job = StreamJob<State, Symbol>;
+    using Result = StreamJobResult<State, Symbol>;
+    using Engine = IExecutionEngine<State, Symbol>;
+
+private:
+    std::unique_ptr<Engine> engine_;
+    BoundedMPMCQueue<Job> intake_;
+    BoundedMPMCQueue<Result> results_;
+    std::atomic<bool> cancel_{false};
+    std::atomic<size_t> active_workers_;
+    std::vector<std::thread> workers_;
+
+    void Work() {
+        if (Tracer::IsEnabled()) {
+            Tracer::Instance().SetThreadName("stream worker");
+        }
+        Job job;
+        while (intake_.Pop(job)) {
+            Result result;
+            result.id = job.id;
+            auto start = std::chrono::steady_clock::now();
+            {
+                TraceSpan span("stream", "execute");
+                span.SetArg("job", static_cast<long long>(job.id));
+                result.outcome = engine_->Execute(job.machine, job.input, job.max_steps, cancel_);
+            }
+            result.execution_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            TraceSpan span("stream", "write result");
+            if (!results_.Push(std::move(result))) {
+                break;   // Выдача закрыта: исполнитель останавливается
+            }
+        }
+        // Последний рабочий поток закрывает выдачу
+        if (active_workers_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            results_.Close();
+        }
+    }
+
+public:
+    /**
+     * @param threads_count Число рабочих потоков
+     * @param queue_capacity Ёмкость очередей приёма и выдачи
+     * @param engine Движок исполнения (по умолчанию интерпретатор)
+     */
+    explicit StreamingBatchRunner(size_t threads_count, size_t queue_capacity = 1024,
+                                  std::unique_ptr<Engine> engine = std::make_unique<InterpreterEngine<State, Symbol>>())
+        : engine_(std::move(engine)),
+          intake_(queue_capacity),
+          results_(queue_capacity),
+          active_workers_(std::max<size_t>(1, threads_count)) {
+        if (!engine_) {
+            throw std::invalid_argument("Не задан движок исполнения");
+        }
+        for (size_t t = 0; t < std::max<size_t>(1, threads_count); ++t) {
+            workers_.emplace_back([this]() { Work(); });
+        }
+    }
+
+    StreamingBatchRunner(const StreamingBatchRunner&) = delete;
+    StreamingBatchRunner& operator=(const StreamingBatchRunner&) = delete;
+
+    /**
+     * Незавершённые задания отменяются, невыданные результаты теряются
+     */
+    ~StreamingBatchRunner() {
+        cancel_.store(true, std::memory_order_relaxed);
+        intake_.Close();
+        results_.Close();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    /**
+     * Отправить задание; ждёт, пока в очереди приёма есть место.
+     * Можно вызывать из нескольких потоков
+     * @return false если приём уже закрыт
+     */
+    bool Submit(Job job) {
+        return intake_.Push(std::move(job));
+    }
+
+    /**
+     * Закрыть приём - вызывается после того, как все производители закончили
+     */
+    void CloseIntake() {
+        intake_.Close();
+    }
+
+    /**
+     * Получить следующий результат; ждёт, пока он появится.
+     * Можно вызывать из нескольких потоков
+     * @return false когда приём закрыт и все результаты выданы
+     */
+    bool Next(Result& result) {
+        return results_.Pop(result);
+    }
+
+    /**
+     * Сколько раз Submit ждал места в очереди приёма
+     */
+    size_t GetBlockedSubmits() const {
+        return intake_.GetBlockedPushes();
+    }
+
+    /**
+     * Сколько раз рабочие потоки ждали места в очереди выдачи
+     */
+    size_t GetBlockedResults() const {
+        return results_.GetBlockedPushes();
+    }
+
+    size_t GetThreadsCount() const {
+        return workers_.size();
+    }
+};
@@ -0,0 +1,324 @@
+#pragma once
+
+#include "TapeStorage.h"
+
+#include <array>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+/**
+ * Статистика хранилища блоков
+ */
+struct ChunkStoreStatistics {
+    size_t unique_chunks = 0;     // Живых уникальных блоков
+    size_t stored_bytes = 0;      // Их суммарный объём
+    size_t intern_requests = 0;   // Сколько раз блоки сдавались на хранение
+    size_t dedup_hits = 0;        // Сколько раз блок уже был в хранилище
+};
+
+/**
+ * Общее хранилище неизменяемых блоков ленты с адресацией по содержимому
+ * Одинаковые блоки существуют в памяти в одном экземпляре (hash-consing).
+ * Блоки живут, пока на них ссылается хоть одна лента; хранилище держит
+ * только слабые ссылки. Потокобезопасно: таблица разбита на шарды со своими мьютексами
+ */
+template <typename Symbol>
+class ChunkStore {
+public:
+    using Chunk = std::vector<Symbol>;
+    using ChunkPtr = std::shared_ptr<const Chunk>;
+
+private:
+    static constexpr size_t SHARDS_COUNT = 16;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_multimap<size_t, std::weak_ptr<const Chunk>> chunks;
+        size_t intern_requests = 0;
+        size_t dedup_hits = 0;
+    };
+
+    std::array<Shard, SHARDS_COUNT> shards_;
+
+    static size_t HashChunk(const Chunk& chunk) {
+        size_t hash = 0xcbf29ce484222325ULL;
+        for (const auto& symbol : chunk) {
+            hash ^= std::hash<Symbol>{}(symbol);
+            hash *= 0x100000001b3ULL;
+        }
+        return hash ^ (hash >> 29);
+    }
+
+public:
+    /**
+     * Хранилище, общее для всех лент данного типа символов
+     */
+    static std::shared_ptr<ChunkStore> GetDefault() {
+        static std::shared_ptr<ChunkStore> store = std::make_shared<ChunkStore>();
+        return store;
+    }
+
+    /**
+     * Сдать блок на хранение
+     * @return Общий экземпляр блока с тем же содержимым
+     */
+    ChunkPtr Intern(const Chunk& chunk) {
+        size_t hash = HashChunk(chunk);
+        Shard& shard = shards_[hash % SHARDS_COUNT];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.intern_requests++;
+
+        auto range = shard.chunks.equal_range(hash);
+        for (auto it = range.first; it != range.second;) {
+            if (auto existing = it->second.lock()) {
+                if (*existing == chunk) {
+                    shard.dedup_hits++;
+                    return existing;
+                }
+                ++it;
+            } else {
+                it = shard.chunks.erase(it);   // Заодно чистим умершие блоки
+            }
+        }
+
+        // Отдельное выделение: память блока освобождается сразу со смертью последней ссылки
+        ChunkPtr created(new Chunk(chunk));
+        shard.chunks.emplace(hash, created);
+        return created;
+    }
+
+    /**
+     * Удалить записи об умерших блоках
+     * @return Сколько записей удалено
+     */
+    size_t Collect() {
+        size_t removed = 0;
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (auto it = shard.chunks.begin(); it != shard.chunks.end();) {
+                if (it->second.expired()) {
+                    it = shard.chunks.erase(it);
+                    removed++;
+                } else {
+                    ++it;
+                }
+            }
+        }
+        return removed;
+    }
+
+    ChunkStoreStatistics GetStatistics() const {
+        ChunkStoreStatistics statistics;
+        for (const auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            statistics.intern_requests += shard.intern_requests;
+            statistics.dedup_hits += shard.dedup_hits;
+            for (const auto& [hash, weak] : shard.chunks) {
+                if (auto chunk = weak.lock()) {
+                    statistics.unique_chunks++;
+                    statistics.stored_bytes += chunk->size() * sizeof(Symbol);
+                }
+            }
+        }
+        return statistics;
+    }
+};
+
+/**
+ * Хранилище ленты поверх общего ChunkStore
+ * Лента - таблица ссылок на неизменяемые общие блоки. Запись копирует
+ * блок в личный изменяемый блок (copy-on-write); при переходе записи
+ * в другой блок личный блок сдаётся в хранилище. Полностью пустые
+ * блоки не хранятся. Копия ленты разделяет все блоки с оригиналом
+ */
+template <typename Symbol, int ChunkSize = 256>
+class DedupTapeStorage {
+    static_assert(ChunkSize > 0, "Размер блока должен быть положительным");
+
+public:
+    using Store = ChunkStore<Symbol>;
+    static constexpr int CHUNK_SIZE = ChunkSize;
+
+private:
+    using Layout = ChunkedTapeStorage<Symbol, ChunkSize>;
+
+    std::shared_ptr<Store> store_;
+    using ChunkTable = std::unordered_map<int, typename Store::ChunkPtr, std::hash<int>, std::equal_to<int>,
+                                          TrackingAllocator<std::pair<const int, typename Store::ChunkPtr>>>;
+
+    ChunkTable chunks_;
+    Symbol blank_symbol_;
+    int first_ = 0;
+    int last_ = -1;
+
+    // Личный блок, в который сейчас идёт запись
+    bool has_dirty_ = false;
+    int dirty_index_ = 0;
+    std::vector<Symbol> dirty_;
+
+    bool IsBlankChunk(const std::vector<Symbol>& chunk) const {
+        return std::all_of(chunk.begin(), chunk.end(),
+                           [this](const Symbol& symbol) { return symbol == blank_symbol_; });
+    }
+
+    void StoreChunk(int index, const std::vector<Symbol>& chunk) {
+        if (IsBlankChunk(chunk)) {
+            chunks_.erase(index);
+        } else {
+            chunks_[index] = store_->Intern(chunk);
+        }
+    }
+
+    void UpdateRange(int position) {
+        if (first_ > last_) {
+            first_ = last_ = position;
+        } else {
+            first_ = std::min(first_, position);
+            last_ = std::max(last_, position);
+        }
+    }
+
+public:
+    explicit DedupTapeStorage(const Symbol& blank_symbol, const std::vector<Symbol>& initial_data = {})
+        : store_(Store::GetDefault()), blank_symbol_(blank_symbol) {
+        Reset(initial_data);
+    }
+
+    Symbol Get(int position) const {
+        int index = Layout::ChunkIndex(position);
+        if (has_dirty_ && index == dirty_index_) {
+            return dirty_[Layout::ChunkOffset(position)];
+        }
+        auto it = chunks_.find(index);
+        return it != chunks_.end() ? (*it->second)[Layout::ChunkOffset(position)] : blank_symbol_;
+    }
+
+    /**
+     * Прочитать count ячеек начиная с first
+     */
+    void ReadSegment(int first, size_t count, Symbol* out) const {
+        size_t done = 0;
+        while (done < count) {
+            int position = first + static_cast<int>(done);
+            int index = Layout::ChunkIndex(position);
+            size_t offset = static_cast<size_t>(Layout::ChunkOffset(position));
+            size_t piece = std::min(count - done, static_cast<size_t>(ChunkSize) - offset);
+            const std::vector<Symbol>* chunk = nullptr;
+            if (has_dirty_ && index == dirty_index_) {
+                chunk = &dirty_;
+            } else {
+                auto it = chunks_.find(index);
+                if (it != chunks_.end()) chunk = it->second.get();
+            }
+            if (chunk) {
+                std::copy_n(chunk->begin() + static_cast<std::ptrdiff_t>(offset), piece, out + done);
+            } else {
+                std::fill_n(out + done, piece, blank_symbol_);
+            }
+            done += piece;
+        }
+    }
+
+    void Set(int position, const Symbol& symbol) {
+        int index = Layout::ChunkIndex(position);
+        if (!has_dirty_ || index != dirty_index_) {
+            Seal();
+            auto it = chunks_.find(index);
+            if (it != chunks_.end()) {
+                dirty_ = *it->second;
+                chunks_.erase(it);
+            } else {
+                dirty_.assign(ChunkSize, blank_symbol_);
+            }
+            dirty_index_ = index;
+            has_dirty_ = true;
+        }
+        dirty_[Layout::ChunkOffset(position)] = symbol;
+        UpdateRange(position);
+    }
+
+    /**
+     * Сдать личный блок в общее хранилище
+     */
+    void Seal() {
+        if (has_dirty_) {
+            StoreChunk(dirty_index_, dirty_);
+            has_dirty_ = false;
+        }
+    }
+
+    void Reset(const std::vector<Symbol>& new_initial_data) {
+        chunks_.clear();
+        has_dirty_ = false;
+        first_ = 0;
+        last_ = -1;
+
+        // Вход сразу режется на блоки: одинаковые входы разных машин делят блоки
+        std::vector<Symbol> chunk;
+        for (size_t begin = 0; begin < new_initial_data.size(); begin += ChunkSize) {
+            size_t end = std::min(new_initial_data.size(), begin + ChunkSize);
+            chunk.assign(new_initial_data.begin() + static_cast<std::ptrdiff_t>(begin),
+                         new_initial_data.begin() + static_cast<std::ptrdiff_t>(end));
+            chunk.resize(ChunkSize, blank_symbol_);
+            StoreChunk(static_cast<int>(begin / ChunkSize), chunk);
+        }
+        if (!new_initial_data.empty()) {
+            first_ = 0;
+            last_ = static_cast<int>(new_initial_data.size()) - 1;
+        }
+    }
+
+    const Symbol& GetBlankSymbol() const {
+        return blank_symbol_;
+    }
+
+    void SetBlankSymbol(const Symbol& blank_symbol) {
+        blank_symbol_ = blank_symbol;
+    }
+
+    std::pair<int, int> GetUsedRange() const {
+        return {first_, last_};
+    }
+
+    /**
+     * Ячеек, на которые ссылается лента (общие блоки считаются целиком)
+     */
+    size_t GetStoredCellsCount() const {
+        return (chunks_.size() + (has_dirty_ ? 1 : 0)) * ChunkSize;
+    }
+
+    /**
+     * Ссылок на общие блоки (без личного блока)
+     */
+    size_t GetSharedChunksCount() const {
+        return chunks_.size();
+    }
+
+    /**
+     * Собственная память ленты без общих блоков (байт, приблизительно)
+     */
+    size_t GetPrivateBytes() const {
+        return sizeof(*this) + chunks_.get_allocator().GetAllocatedBytes() + dirty_.capacity() * sizeof(Symbol);
+    }
+
+    /**
+     * Память ленты; общие блоки считаются в основе целиком, хотя могут
+     * делиться с другими лентами того же хранилища
+     */
+    MemoryFootprint GetMemoryFootprint() const {
+        MemoryFootprint footprint;
+        footprint.tape_base = chunks_.size() * ChunkSize * sizeof(Symbol);
+        footprint.tape_overlay = chunks_.get_allocator().GetAllocatedBytes() + dirty_.capacity() * sizeof(Symbol);
+        footprint.metadata = sizeof(*this);
+        return footprint;
+    }
+
+    const std::shared_ptr<Store>& GetStore() const {
+        return store_;
+    }
+};
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * Ограниченная lock-free очередь с несколькими производителями и потребителями
+ * Кольцевой буфер с порядковыми номерами в ячейках (схема Д. Вьюкова):
+ * каждая операция - один CAS на общем индексе, без мьютексов.
+ * Блокирующие Push / Pop реализуют обратное давление: производитель ждёт,
+ * пока в заполненной очереди освободится место, потребитель - пока появится
+ * элемент или очередь будет закрыта. Ожидание - активное с нарастающей
+ * паузой (повторы, yield, короткий сон), блокировок нет и здесь
+ */
+template <typename T>
+class BoundedMPMCQueue {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    static constexpr size_t CACHE_LINE = 64;
+
+    std::vector<Cell> buffer_;
+    size_t mask_;
+
+    // Индексы разнесены по разным кеш-линиям, чтобы производители
+    // и потребители не мешали друг другу
+    alignas(CACHE_LINE) std::atomic<size_t> enqueue_pos_;
+    alignas(CACHE_LINE) std::atomic<size_t> dequeue_pos_;
+
+    alignas(CACHE_LINE) std::atomic<bool> closed_{false};
+    std::atomic<size_t> blocked_pushes_{0};
+    std::atomic<size_t> blocked_pops_{0};
+
+    /**
+     * Пауза перед очередной попыткой: сначала повтор, затем уступить
+     * процессор, при долгом ожидании - короткий сон
+     */
+    static void Backoff(size_t& attempt) {
+        if (attempt >= 64) {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        } else if (attempt >= 8) {
+            std::this_thread::yield();
+        }
+        attempt++;
+    }
+
+    /**
+     * Добавить элемент; value перемещается только при успехе
+     */
+    bool TryPushFrom(T& value) {
+        Cell* cell;
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &buffer_[pos & mask_];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+public:
+    /**
+     * @param capacity Ёмкость очереди (округляется вверх до степени двойки)
+     */
+    explicit BoundedMPMCQueue(size_t capacity) : enqueue_pos_(0), dequeue_pos_(0) {
+        if (capacity < 2) {
+            capacity = 2;
+        }
+        size_t rounded = 1;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+
+        buffer_ = std::vector<Cell>(rounded);
+        mask_ = rounded - 1;
+        for (size_t i = 0; i < rounded; ++i) {
+            buffer_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedMPMCQueue(const BoundedMPMCQueue&) = delete;
+    BoundedMPMCQueue& operator=(const BoundedMPMCQueue&) = delete;
+
+    /**
+     * Попытаться добавить элемент
+     * @return false если очередь заполнена
+     */
+    bool TryPush(T value) {
+        return TryPushFrom(value);
+    }
+
+    /**
+     * Попытаться извлечь элемент
+     * @return false если очередь пуста
+     */
+    bool TryPop(T& out) {
+        Cell* cell;
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &buffer_[pos & mask_];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        out = std::move(cell->value);
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Добавить элемент, дождавшись свободного места
+     * @return false если очередь закрыта (элемент не добавлен)
+     */
+    bool Push(T value) {
+        size_t attempt = 0;
+        while (!closed_.load(std::memory_order_acquire)) {
+            if (TryPushFrom(value)) {
+                return true;
+            }
+            if (attempt == 0) {
+                blocked_pushes_.fetch_add(1, std::memory_order_relaxed);
+            }
+            Backoff(attempt);
+        }
+        return false;
+    }
+
+    /**
+     * Извлечь элемент, дождавшись его появления
+     * @return false если очередь закрыта и пуста
+     */
+    bool Pop(T& out) {
+        size_t attempt = 0;
+        while (true) {
+            if (TryPop(out)) {
+                return true;
+            }
+            if (closed_.load(std::memory_order_acquire)) {
+                // Все Push завершились до закрытия: повторная попытка видит их элементы
+                return TryPop(out);
+            }
+            if (attempt == 0) {
+                blocked_pops_.fetch_add(1, std::memory_order_relaxed);
+            }
+            Backoff(attempt);
+        }
+    }
+
+    /**
+     * Закрыть очередь: новые Push отклоняются, Pop дочитывает остаток
+     * и возвращает false. Вызывается после того, как все производители
+     * закончили добавлять элементы
+     */
+    void Close() {
+        closed_.store(true, std::memory_order_release);
+    }
+
+    bool IsClosed() const {
+        return closed_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Сколько раз Push ждал места (срабатывания обратного давления)
+     */
+    size_t GetBlockedPushes() const {
+        return blocked_pushes_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Сколько раз Pop ждал элемента
+     */
+    size_t GetBlockedPops() const {
+        return blocked_pops_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Приблизительный размер (точен только при отсутствии конкурентных операций)
+     */
+    size_t ApproxSize() const {
+        size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+        size_t head = dequeue_pos_.load(std::memory_order_relaxed);
+        return tail >= head ? tail - head : 0;
+    }
+
+    size_t Capacity() const {
+        return mask_ + 1;
+    }
+};
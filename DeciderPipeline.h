@@ -0,0 +1,257 @@
+#pragma once
+
+#include "ConcurrentQueue.h"
+#include "Deciders.h"
+#include "BackwardReasoning.h"
+
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+
+/**
+ * Результат прохождения машины через конвейер
+ */
+struct PipelineResult {
+    size_t machine_id = 0;
+    DeciderVerdict verdict = DeciderVerdict::UNDECIDED;
+    std::string decided_by;   // Имя стадии, вынесшей вердикт (пусто, если не решено)
+};
+
+/**
+ * Метрики одной стадии конвейера
+ */
+struct StageMetrics {
+    std::string name;
+    size_t threads = 0;
+    size_t received = 0;       // Сколько машин обработано стадией
+    size_t decided = 0;        // Сколько решено
+    size_t escalated = 0;      // Сколько передано дальше
+    size_t max_backlog = 0;    // Максимальная наблюдавшаяся длина входной очереди
+    double busy_seconds = 0.0; // Суммарное время работы децайдера по всем потокам
+    double wall_seconds = 0.0; // Время от старта конвейера до завершения стадии
+
+    double GetThroughput() const {
+        return wall_seconds > 0.0 ? static_cast<double>(received) / wall_seconds : 0.0;
+    }
+};
+
+/**
+ * Конвейер децайдеров с нарастающим бюджетом
+ * Ответственность: прогон машин через стадии от дешёвых к дорогим.
+ * У каждой стадии свой пул потоков; стадии соединены ограниченными
+ * lock-free очередями, дальше проходят только нерешённые машины
+ */
+class DeciderPipeline {
+public:
+    using Decider = std::function<DeciderVerdict(const CandidateMachine&)>;
+
+private:
+    // Элемент очереди: индекс машины во входном массиве
+    using Ticket = size_t;
+
+    struct StageConfig {
+        std::string name;
+        size_t threads;
+        Decider decider;
+    };
+
+    struct StageRuntime {
+        std::unique_ptr<BoundedMPMCQueue<Ticket>> queue;
+        std::atomic<size_t> received{0};
+        std::atomic<size_t> decided{0};
+        std::atomic<size_t> escalated{0};
+        std::atomic<size_t> max_backlog{0};
+        std::atomic<long long> busy_nanos{0};
+        std::atomic<size_t> active_workers{0};
+        double wall_seconds = 0.0;
+    };
+
+    std::vector<StageConfig> stages_;
+    size_t queue_capacity_;
+    std::vector<StageMetrics> metrics_;
+
+    static void UpdateMax(std::atomic<size_t>& target, size_t value) {
+        size_t current = target.load(std::memory_order_relaxed);
+        while (value > current &&
+               !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * Положить машину в очередь стадии; при заполнении очереди ждём (обратное давление)
+     */
+    static void PushWithBackpressure(StageRuntime& stage, Ticket ticket) {
+        stage.queue->Push(ticket);
+        UpdateMax(stage.max_backlog, stage.queue->ApproxSize());
+    }
+
+public:
+    explicit DeciderPipeline(size_t queue_capacity = 1024)
+        : queue_capacity_(queue_capacity) {}
+
+    /**
+     * Добавить стадию в конец конвейера
+     */
+    void AddStage(const std::string& name, size_t threads, Decider decider) {
+        if (threads == 0) {
+            throw std::invalid_argument("Стадии нужен хотя бы один поток");
+        }
+        stages_.push_back({name, threads, std::move(decider)});
+    }
+
+    size_t GetStagesCount() const {
+        return stages_.size();
+    }
+
+    /**
+     * Прогнать машины через все стадии
+     * @return Результаты в порядке входного массива
+     */
+    std::vector<PipelineResult> Run(const std::vector<CandidateMachine>& machines) {
+        std::vector<PipelineResult> results(machines.size());
+        for (size_t i = 0; i < machines.size(); ++i) {
+            results[i].machine_id = machines[i].id;
+        }
+        if (stages_.empty()) {
+            metrics_.clear();
+            return results;
+        }
+
+        std::vector<std::unique_ptr<StageRuntime>> runtime;
+        for (size_t s = 0; s < stages_.size(); ++s) {
+            auto stage = std::make_unique<StageRuntime>();
+            stage->queue = std::make_unique<BoundedMPMCQueue<Ticket>>(queue_capacity_);
+            stage->active_workers.store(stages_[s].threads);
+            runtime.push_back(std::move(stage));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        auto worker = [&](size_t s) {
+            StageRuntime& stage = *runtime[s];
+            StageRuntime* next = (s + 1 < runtime.size()) ? runtime[s + 1].get() : nullptr;
+
+            // Ждём в Pop, пока предыдущая стадия не закроет очередь и она не опустеет
+            Ticket ticket;
+            while (stage.queue->Pop(ticket)) {
+                auto busy_start = std::chrono::steady_clock::now();
+                DeciderVerdict verdict = stages_[s].decider(machines[ticket]);
+                auto busy_end = std::chrono::steady_clock::now();
+                stage.busy_nanos.fetch_add(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(busy_end - busy_start).count(),
+                    std::memory_order_relaxed);
+                stage.received.fetch_add(1, std::memory_order_relaxed);
+
+                if (verdict != DeciderVerdict::UNDECIDED) {
+                    results[ticket].verdict = verdict;
+                    results[ticket].decided_by = stages_[s].name;
+                    stage.decided.fetch_add(1, std::memory_order_relaxed);
+                } else if (next) {
+                    stage.escalated.fetch_add(1, std::memory_order_relaxed);
+                    PushWithBackpressure(*next, ticket);
+                }
+            }
+
+            // Последний завершившийся поток закрывает очередь следующей стадии
+            if (stage.active_workers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                stage.wall_seconds = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start).count();
+                if (next) {
+                    next->queue->Close();
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t s = 0; s < stages_.size(); ++s) {
+            for (size_t t = 0; t < stages_[s].threads; ++t) {
+                threads.emplace_back(worker, s);
+            }
+        }
+
+        for (size_t i = 0; i < machines.size(); ++i) {
+            PushWithBackpressure(*runtime[0], i);
+        }
+        runtime[0]->queue->Close();
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        metrics_.clear();
+        for (size_t s = 0; s < stages_.size(); ++s) {
+            const StageRuntime& stage = *runtime[s];
+            StageMetrics m;
+            m.name = stages_[s].name;
+            m.threads = stages_[s].threads;
+            m.received = stage.received.load();
+            m.decided = stage.decided.load();
+            m.escalated = stage.escalated.load();
+            m.max_backlog = stage.max_backlog.load();
+            m.busy_seconds = static_cast<double>(stage.busy_nanos.load()) / 1e9;
+            m.wall_seconds = stage.wall_seconds;
+            metrics_.push_back(m);
+        }
+
+        return results;
+    }
+
+    /**
+     * Метрики последнего запуска
+     */
+    const std::vector<StageMetrics>& GetStageMetrics() const {
+        return metrics_;
+    }
+
+    /**
+     * Вывести метрики стадий
+     */
+    void PrintMetrics(std::ostream& out = std::cout) const {
+        out << "=== Метрики конвейера децайдеров ===" << std::endl;
+        for (const auto& m : metrics_) {
+            out << std::left << std::setw(20) << m.name
+                << " потоков: " << m.threads
+                << ", обработано: " << m.received
+                << ", решено: " << m.decided
+                << ", дальше: " << m.escalated
+                << ", макс. очередь: " << m.max_backlog
+                << ", машин/с: " << std::fixed << std::setprecision(0) << m.GetThroughput()
+                << std::defaultfloat << std::endl;
+        }
+    }
+
+    /**
+     * Стандартный конвейер: короткая симуляция, циклы, сдвинутые циклы,
+     * длинная симуляция и обратный анализ
+     * @param threads_per_stage Потоков на каждую стадию
+     */
+    static DeciderPipeline MakeDefault(size_t threads_per_stage = 1,
+                                       size_t short_steps = 100,
+                                       size_t long_steps = 100000) {
+        DeciderPipeline pipeline;
+        SimulationDecider short_sim(short_steps);
+        CyclerDecider cycler(1000);
+        TranslatedCyclerDecider translated(5000);
+        SimulationDecider long_sim(long_steps);
+        BackwardReasoningAnalyzer backward;
+
+        pipeline.AddStage("short-simulation", threads_per_stage,
+                          [short_sim](const CandidateMachine& m) { return short_sim.Decide(m); });
+        pipeline.AddStage("cycler", threads_per_stage,
+                          [cycler](const CandidateMachine& m) { return cycler.Decide(m); });
+        pipeline.AddStage("translated-cycler", threads_per_stage,
+                          [translated](const CandidateMachine& m) { return translated.Decide(m); });
+        pipeline.AddStage("long-simulation", threads_per_stage,
+                          [long_sim](const CandidateMachine& m) { return long_sim.Decide(m); });
+        pipeline.AddStage("backward-reasoning", threads_per_stage,
+                          [backward](const CandidateMachine& m) { return backward.Decide(m); });
+        return pipeline;
+    }
+};
@@ -0,0 +1,286 @@
+#pragma once
+
+#include "MachineEnumerator.h"
+
+#include <vector>
+#include <algorithm>
+
+/**
+ * Вердикт децайдера об остановке машины на пустой ленте
+ */
+enum class DeciderVerdict {
+    HALTS,          // Машина останавливается (доказано симуляцией)
+    NON_HALTING,    // Машина никогда не останавливается (доказано)
+    UNDECIDED       // Децайдер не смог решить в пределах бюджета
+};
+
+/**
+ * Машина-кандидат из перечисления
+ * Переход, отсутствующий в таблице, означает остановку
+ */
+struct CandidateMachine {
+    size_t id = 0;
+    int states_count = 0;
+    int symbols_count = 0;
+    MachineEnumerator::Table table;
+
+    const MachineTableEntry& GetEntry(int state, int symbol) const {
+        return table[static_cast<size_t>(state * symbols_count + symbol)];
+    }
+};
+
+/**
+ * Быстрый симулятор таблицы переходов для децайдеров
+ * Лента - непрерывный вектор, растущий в обе стороны; пустой символ 0
+ */
+class TableSimulator {
+private:
+    const CandidateMachine& machine_;
+    std::vector<int> tape_;
+    size_t origin_;          // Индекс позиции 0 в tape_
+    int head_;
+    int state_;
+    size_t step_count_;
+    bool halted_;
+    int min_position_;
+    int max_position_;
+
+    void EnsureCapacity(int position) {
+        auto index = static_cast<long long>(origin_) + position;
+        if (index < 0) {
+            size_t grow = std::max(tape_.size(), static_cast<size_t>(-index));
+            tape_.insert(tape_.begin(), grow, 0);
+            origin_ += grow;
+        } else if (static_cast<size_t>(index) >= tape_.size()) {
+            size_t grow = std::max(tape_.size(), static_cast<size_t>(index) - tape_.size() + 1);
+            tape_.insert(tape_.end(), grow, 0);
+        }
+    }
+
+public:
+    explicit TableSimulator(const CandidateMachine& machine)
+        : machine_(machine), tape_(64, 0), origin_(32), head_(0), state_(0),
+          step_count_(0), halted_(false), min_position_(0), max_position_(0) {}
+
+    /**
+     * Выполнить один шаг
+     * @return false если переход не определён (машина остановилась)
+     */
+    bool Step() {
+        if (halted_) return false;
+
+        int& cell = tape_[origin_ + head_];
+        const auto& entry = machine_.GetEntry(state_, cell);
+        if (!entry.defined) {
+            halted_ = true;
+            return false;
+        }
+
+        cell = entry.write_symbol;
+        state_ = entry.to_state;
+        head_ += static_cast<int>(entry.direction);
+        step_count_++;
+
+        EnsureCapacity(head_);
+        min_position_ = std::min(min_position_, head_);
+        max_position_ = std::max(max_position_, head_);
+        return true;
+    }
+
+    int GetSymbolAt(int position) const {
+        auto index = static_cast<long long>(origin_) + position;
+        if (index < 0 || static_cast<size_t>(index) >= tape_.size()) return 0;
+        return tape_[static_cast<size_t>(index)];
+    }
+
+    int GetState() const { return state_; }
+    int GetHeadPosition() const { return head_; }
+    size_t GetStepCount() const { return step_count_; }
+    bool IsHalted() const { return halted_; }
+    int GetMinPosition() const { return min_position_; }
+    int GetMaxPosition() const { return max_position_; }
+};
+
+/**
+ * Децайдер-симуляция: машина останавливается за max_steps шагов
+ */
+class SimulationDecider {
+private:
+    size_t max_steps_;
+
+public:
+    explicit SimulationDecider(size_t max_steps) : max_steps_(max_steps) {}
+
+    DeciderVerdict Decide(const CandidateMachine& machine) const {
+        TableSimulator simulator(machine);
+        while (simulator.GetStepCount() < max_steps_) {
+            if (!simulator.Step()) {
+                return DeciderVerdict::HALTS;
+            }
+        }
+        return DeciderVerdict::UNDECIDED;
+    }
+};
+
+/**
+ * Детектор циклов: полная конфигурация повторилась - машина зациклена
+ * Алгоритм Брента: конфигурация запоминается на шагах 2^k и сравнивается
+ * с текущей; лента сравнивается только при совпадении состояния и головки
+ */
+class CyclerDecider {
+private:
+    size_t max_steps_;
+
+    struct Snapshot {
+        int state;
+        int head;
+        int min_position;
+        std::vector<int> cells;   // Ячейки [min_position, max_position]
+    };
+
+    static Snapshot TakeSnapshot(const TableSimulator& simulator) {
+        Snapshot snapshot{simulator.GetState(), simulator.GetHeadPosition(), simulator.GetMinPosition(), {}};
+        for (int p = simulator.GetMinPosition(); p <= simulator.GetMaxPosition(); ++p) {
+            snapshot.cells.push_back(simulator.GetSymbolAt(p));
+        }
+        return snapshot;
+    }
+
+    static bool SameConfiguration(const Snapshot& snapshot, const TableSimulator& simulator) {
+        if (snapshot.state != simulator.GetState() || snapshot.head != simulator.GetHeadPosition()) {
+            return false;
+        }
+        // Вне сохранённого диапазона на снимке были пустые ячейки
+        for (int p = simulator.GetMinPosition(); p <= simulator.GetMaxPosition(); ++p) {
+            auto index = static_cast<long long>(p) - snapshot.min_position;
+            int old_symbol = (index >= 0 && static_cast<size_t>(index) < snapshot.cells.size())
+                ? snapshot.cells[static_cast<size_t>(index)] : 0;
+            if (old_symbol != simulator.GetSymbolAt(p)) return false;
+        }
+        return true;
+    }
+
+public:
+    explicit CyclerDecider(size_t max_steps) : max_steps_(max_steps) {}
+
+    DeciderVerdict Decide(const CandidateMachine& machine) const {
+        TableSimulator simulator(machine);
+        Snapshot saved = TakeSnapshot(simulator);
+        size_t next_checkpoint = 1;
+
+        while (simulator.GetStepCount() < max_steps_) {
+            if (!simulator.Step()) {
+                return DeciderVerdict::HALTS;
+            }
+            if (SameConfiguration(saved, simulator)) {
+                return DeciderVerdict::NON_HALTING;
+            }
+            if (simulator.GetStepCount() == next_checkpoint) {
+                saved = TakeSnapshot(simulator);
+                next_checkpoint *= 2;
+            }
+        }
+        return DeciderVerdict::UNDECIDED;
+    }
+};
+
+/**
+ * Детектор сдвинутых циклов
+ * В моменты обновления рекорда позиции (справа или слева) запоминается
+ * состояние и окно ленты у края. Если в двух рекордах совпали состояние
+ * и всё содержимое, которое головка успела прочитать между ними,
+ * поведение повторяется со сдвигом бесконечно
+ */
+class TranslatedCyclerDecider {
+private:
+    size_t max_steps_;
+    int window_;              // Максимальная глубина отката головки от края
+    size_t records_checked_;  // Сколько последних рекордов сравнивать с новым
+
+    struct Record {
+        size_t step;
+        int state;
+        int position;
+        std::vector<int> segment;   // Ячейки [position - window_, position] (от края вглубь)
+    };
+
+    bool SegmentMatches(const Record& earlier, const TableSimulator& simulator, int depth, int side) const {
+        int current = simulator.GetHeadPosition();
+        for (int d = 0; d <= depth; ++d) {
+            if (earlier.segment[static_cast<size_t>(d)] != simulator.GetSymbolAt(current - side * d)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Record MakeRecord(const TableSimulator& simulator, int side) const {
+        Record record{simulator.GetStepCount(), simulator.GetState(), simulator.GetHeadPosition(), {}};
+        record.segment.resize(static_cast<size_t>(window_) + 1);
+        for (int d = 0; d <= window_; ++d) {
+            record.segment[static_cast<size_t>(d)] = simulator.GetSymbolAt(record.position - side * d);
+        }
+        return record;
+    }
+
+    /**
+     * Сравнить новый рекорд с предыдущими рекордами той же стороны
+     * История головки просматривается назад один раз для всех кандидатов
+     */
+    bool FindTranslatedCycle(const std::vector<Record>& records, const TableSimulator& simulator,
+                             const std::vector<int>& head_history, int side) const {
+        // Самая глубокая (от края) позиция головки на просмотренном суффиксе истории
+        int deepest = side * simulator.GetHeadPosition();
+        size_t t = head_history.size();
+        size_t checked = 0;
+
+        for (auto it = records.rbegin(); it != records.rend() && checked < records_checked_; ++it) {
+            while (t > it->step) {
+                --t;
+                deepest = std::min(deepest, side * head_history[t]);
+            }
+            if (it->state != simulator.GetState()) continue;
+            checked++;
+
+            int depth = side * it->position - deepest;
+            if (depth <= window_ && SegmentMatches(*it, simulator, depth, side)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    explicit TranslatedCyclerDecider(size_t max_steps, int window = 64, size_t records_checked = 32)
+        : max_steps_(max_steps), window_(window), records_checked_(records_checked) {}
+
+    DeciderVerdict Decide(const CandidateMachine& machine) const {
+        TableSimulator simulator(machine);
+        std::vector<int> head_history;
+        std::vector<Record> right_records;
+        std::vector<Record> left_records;
+        int right_edge = 0;
+        int left_edge = 0;
+
+        while (simulator.GetStepCount() < max_steps_) {
+            int position = simulator.GetHeadPosition();
+            head_history.push_back(position);
+
+            if (position > right_edge || position < left_edge) {
+                int side = (position > right_edge) ? 1 : -1;
+                auto& records = (side == 1) ? right_records : left_records;
+                if (FindTranslatedCycle(records, simulator, head_history, side)) {
+                    return DeciderVerdict::NON_HALTING;
+                }
+                records.push_back(MakeRecord(simulator, side));
+                right_edge = std::max(right_edge, position);
+                left_edge = std::min(left_edge, position);
+            }
+
+            if (!simulator.Step()) {
+                return DeciderVerdict::HALTS;
+            }
+        }
+        return DeciderVerdict::UNDECIDED;
+    }
+};
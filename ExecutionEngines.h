@@ -0,0 +1,545 @@
+#pragma once
+
+#include "MT.h"
+
+#include <atomic>
+#include <vector>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+/**
+ * Описание машины, независимое от способа исполнения
+ * Головка стартует в позиции 0, входные данные лежат с позиции 0
+ */
+template <typename State, typename Symbol>
+struct MachineDefinition {
+    State initial_state;
+    Symbol blank_symbol;
+    std::vector<TransitionRule<State, Symbol>> rules;
+    std::vector<State> final_states;
+
+    /**
+     * Снять описание с настроенной машины
+     */
+    static MachineDefinition FromMachine(const TuringMachine<State, Symbol>& machine) {
+        MachineDefinition definition{machine.GetInitialState(), machine.GetBlankSymbol(),
+                                     machine.GetTransitionManager().GetAllRules(), {}};
+        const auto& finals = machine.GetStateManager().GetFinalStates();
+        definition.final_states.assign(finals.begin(), finals.end());
+        return definition;
+    }
+
+    /**
+     * Построить машину по описанию на заданном входе
+     */
+    UniquePtr<TuringMachine<State, Symbol>> Instantiate(const std::vector<Symbol>& input) const {
+        auto machine = [&]() {
+            TraceSpan span("machine", "load input");
+            return MakeTuringMachine(initial_state, blank_symbol, input);
+        }();
+
+        TraceSpan span("machine", "compile");
+        for (const auto& rule : rules) {
+            machine->AddTransition(rule.from_state, rule.read_symbol, rule.to_state, rule.write_symbol, rule.direction);
+        }
+        for (const auto& state : final_states) {
+            machine->AddFinalState(state);
+        }
+        return machine;
+    }
+
+    /**
+     * Отпечаток машины (не зависит от порядка правил)
+     */
+    size_t GetFingerprint() const {
+        auto mix = [](size_t h) {
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            return h;
+        };
+        size_t fingerprint = mix(std::hash<State>{}(initial_state)) ^ mix(std::hash<Symbol>{}(blank_symbol) + 1);
+        for (const auto& rule : rules) {
+            size_t h = std::hash<State>{}(rule.from_state);
+            h = mix(h ^ (std::hash<Symbol>{}(rule.read_symbol) + 0x9e3779b97f4a7c15ULL));
+            h = mix(h ^ std::hash<State>{}(rule.to_state));
+            h = mix(h ^ std::hash<Symbol>{}(rule.write_symbol));
+            h = mix(h ^ static_cast<size_t>(static_cast<int>(rule.direction) + 2));
+            fingerprint += h;
+        }
+        for (const auto& state : final_states) {
+            fingerprint += mix(std::hash<State>{}(state) + 0x632be59bd9b4e019ULL);
+        }
+        return fingerprint;
+    }
+};
+
+/**
+ * Результат исполнения машины движком
+ * Лента возвращается на отрезке [tape_start, tape_start + tape.size()),
+ * покрывающем вход и все посещённые головкой ячейки
+ */
+template <typename State, typename Symbol>
+struct EngineOutcome {
+    ExecutionResult result = ExecutionResult::ERROR;
+    size_t steps = 0;
+    State final_state{};
+    int head_position = 0;
+    int tape_start = 0;
+    std::vector<Symbol> tape;
+    bool cancelled = false;   // Исполнение прервано извне, результат недействителен
+
+    bool SameAs(const EngineOutcome& other) const {
+        return result == other.result && steps == other.steps && final_state == other.final_state &&
+               head_position == other.head_position && tape_start == other.tape_start && tape == other.tape;
+    }
+};
+
+/**
+ * Интерфейс движка исполнения
+ * Все движки обязаны давать результат, совпадающий с TuringMachine::Run
+ */
+template <typename State, typename Symbol>
+class IExecutionEngine {
+public:
+    virtual ~IExecutionEngine() = default;
+
+    virtual std::string GetName() const = 0;
+
+    /**
+     * Исполнить машину
+     * @param cancel Флаг отмены, проверяется периодически
+     */
+    virtual EngineOutcome<State, Symbol> Execute(const MachineDefinition<State, Symbol>& machine,
+                                                 const std::vector<Symbol>& input,
+                                                 size_t max_steps,
+                                                 const std::atomic<bool>& cancel) const = 0;
+
+protected:
+    static constexpr size_t CANCEL_CHECK_INTERVAL = 4096;
+
+    /**
+     * Границы выходного отрезка ленты
+     */
+    static std::pair<int, int> OutputRange(size_t input_size, int min_head, int max_head) {
+        int start = std::min(0, min_head);
+        int end = std::max(static_cast<int>(input_size) - 1, max_head);
+        return {start, std::max(start, end)};
+    }
+};
+
+/**
+ * Простой интерпретатор: пошаговое исполнение TuringMachine
+ */
+template <typename State, typename Symbol>
+class InterpreterEngine : public IExecutionEngine<State, Symbol> {
+public:
+    std::string GetName() const override {
+        return "interpreter";
+    }
+
+    EngineOutcome<State, Symbol> Execute(const MachineDefinition<State, Symbol>& machine,
+                                         const std::vector<Symbol>& input,
+                                         size_t max_steps,
+                                         const std::atomic<bool>& cancel) const override {
+        TuringMachine<State, Symbol> tm(machine.initial_state, machine.blank_symbol, input);
+        for (const auto& rule : machine.rules) {
+            tm.AddTransition(rule.from_state, rule.read_symbol, rule.to_state, rule.write_symbol, rule.direction);
+        }
+        for (const auto& state : machine.final_states) {
+            tm.AddFinalState(state);
+        }
+        tm.SetMaxSteps(max_steps);
+
+        EngineOutcome<State, Symbol> outcome;
+        ProfiledRegion profiled(ProfileStateId(machine.initial_state), 0);
+        // Тот же цикл, что и в TuringMachine::Run, но с проверкой отмены
+        while (true) {
+            if (tm.IsInFinalState()) {
+                outcome.result = ExecutionResult::ACCEPTED;
+                break;
+            }
+            if (tm.GetStepCount() >= max_steps) {
+                outcome.result = ExecutionResult::TIMEOUT;
+                break;
+            }
+            if (tm.GetStepCount() % this->CANCEL_CHECK_INTERVAL == 0 && cancel.load(std::memory_order_relaxed)) {
+                outcome.cancelled = true;
+                return outcome;
+            }
+            if (!tm.Step()) {
+                outcome.result = ExecutionResult::REJECTED;
+                break;
+            }
+        }
+
+        outcome.steps = tm.GetStepCount();
+        outcome.final_state = tm.GetCurrentState();
+        outcome.head_position = tm.GetHeadPosition();
+        auto [start, end] = this->OutputRange(input.size(), tm.GetHeadManager().GetMinPosition(),
+                                              tm.GetHeadManager().GetMaxPosition());
+        outcome.tape_start = start;
+        outcome.tape = tm.GetTapeSegment(start, static_cast<size_t>(end - start + 1));
+        return outcome;
+    }
+};
+
+/**
+ * Движок с ускорением цепочек (chain step)
+ * Лента хранится как серии одинаковых символов по обе стороны от головки.
+ * Правило (s, a) -> (s, w, d) над серией символов a выполняется за один
+ * шаг движка независимо от длины серии
+ */
+template <typename State, typename Symbol>
+class ChainStepEngine : public IExecutionEngine<State, Symbol> {
+private:
+    using Run = std::pair<Symbol, size_t>;
+
+    /**
+     * Положить count ячеек symbol на стек серий (вершина - ближе к головке)
+     */
+    static void PushRun(std::vector<Run>& stack, const Symbol& symbol, size_t count) {
+        if (count == 0) return;
+        if (!stack.empty() && stack.back().first == symbol) {
+            stack.back().second += count;
+        } else {
+            stack.emplace_back(symbol, count);
+        }
+    }
+
+    /**
+     * Снять одну ячейку со стека (за концом стека - пустые символы)
+     */
+    static Symbol PopCell(std::vector<Run>& stack, const Symbol& blank) {
+        if (stack.empty()) return blank;
+        Symbol symbol = stack.back().first;
+        if (--stack.back().second == 0) {
+            stack.pop_back();
+        }
+        return symbol;
+    }
+
+public:
+    std::string GetName() const override {
+        return "chain-step";
+    }
+
+    EngineOutcome<State, Symbol> Execute(const MachineDefinition<State, Symbol>& machine,
+                                         const std::vector<Symbol>& input,
+                                         size_t max_steps,
+                                         const std::atomic<bool>& cancel) const override {
+        TransitionManager<State, Symbol> rules;
+        for (const auto& rule : machine.rules) {
+            rules.AddRule(rule);
+        }
+        StateManager<State> states(machine.initial_state);
+        for (const auto& state : machine.final_states) {
+            states.AddFinalState(state);
+        }
+
+        const Symbol& blank = machine.blank_symbol;
+        std::vector<Run> left;
+        std::vector<Run> right;
+        for (size_t i = input.size(); i-- > 1;) {
+            PushRun(right, input[i], 1);
+        }
+        Symbol head_symbol = input.empty() ? blank : input[0];
+
+        long long head = 0;
+        long long min_head = 0;
+        long long max_head = 0;
+        size_t steps = 0;
+        size_t iterations = 0;
+
+        EngineOutcome<State, Symbol> outcome;
+        ProfiledRegion profiled(ProfileStateId(machine.initial_state), 0);
+        bool profiling = SamplingProfiler::IsEnabled();
+        while (true) {
+            if (states.IsInFinalState()) {
+                outcome.result = ExecutionResult::ACCEPTED;
+                break;
+            }
+            if (steps >= max_steps) {
+                outcome.result = ExecutionResult::TIMEOUT;
+                break;
+            }
+            if (++iterations % this->CANCEL_CHECK_INTERVAL == 0 && cancel.load(std::memory_order_relaxed)) {
+                outcome.cancelled = true;
+                return outcome;
+            }
+
+            auto rule = rules.FindRule(states.GetCurrentState(), head_symbol);
+            if (!rule) {
+                outcome.result = ExecutionResult::REJECTED;
+                break;
+            }
+
+            if (rule->direction == Direction::STAY) {
+                head_symbol = rule->write_symbol;
+                states.SetCurrentState(rule->to_state);
+                steps++;
+                continue;
+            }
+
+            auto& behind = (rule->direction == Direction::RIGHT) ? left : right;
+            auto& ahead = (rule->direction == Direction::RIGHT) ? right : left;
+            size_t count = 1;
+
+            if (rule->to_state == rule->from_state) {
+                // Цепочка: серия символов a впереди проходится целиком
+                size_t remaining = max_steps - steps;
+                if (ahead.empty() && head_symbol == blank) {
+                    count = remaining;   // Бесконечная пустая серия
+                } else if (!ahead.empty() && ahead.back().first == head_symbol) {
+                    count = std::min(remaining, 1 + ahead.back().second);
+                }
+            }
+
+            // count ячеек (текущая + count - 1 впереди) превращаются в write_symbol
+            size_t consumed = count - 1;
+            while (consumed > 0) {
+                size_t take = ahead.empty() ? consumed : std::min(consumed, ahead.back().second);
+                if (!ahead.empty()) {
+                    ahead.back().second -= take;
+                    if (ahead.back().second == 0) ahead.pop_back();
+                }
+                consumed -= take;
+            }
+            PushRun(behind, rule->write_symbol, count);
+            head_symbol = PopCell(ahead, blank);
+
+            long long delta = static_cast<long long>(count) * static_cast<int>(rule->direction);
+            head += delta;
+            min_head = std::min(min_head, head);
+            max_head = std::max(max_head, head);
+            states.SetCurrentState(rule->to_state);
+            steps += count;
+            if (profiling) {
+                SamplingProfiler::Publish(ProfileStateId(rule->to_state), head);
+            }
+        }
+
+        outcome.steps = steps;
+        outcome.final_state = states.GetCurrentState();
+        outcome.head_position = static_cast<int>(head);
+
+        // Восстанавливаем ленту из серий
+        auto [start, end] = this->OutputRange(input.size(), static_cast<int>(min_head), static_cast<int>(max_head));
+        outcome.tape_start = start;
+        outcome.tape.assign(static_cast<size_t>(end - start + 1), blank);
+        auto put = [&](long long position, const Symbol& symbol) {
+            if (position >= start && position <= end) {
+                outcome.tape[static_cast<size_t>(position - start)] = symbol;
+            }
+        };
+        put(head, head_symbol);
+        long long position = head - 1;
+        for (auto it = left.rbegin(); it != left.rend() && position >= start; ++it) {
+            for (size_t i = 0; i < it->second && position >= start; ++i) put(position--, it->first);
+        }
+        position = head + 1;
+        for (auto it = right.rbegin(); it != right.rend() && position <= end; ++it) {
+            for (size_t i = 0; i < it->second && position <= end; ++i) put(position++, it->first);
+        }
+        return outcome;
+    }
+};
+
+/**
+ * Движок макромашины
+ * Лента делится на блоки по block_size ячеек. Переход «состояние, вход в
+ * блок, содержимое блока» -> «выход из блока» вычисляется один раз и
+ * кешируется; дальше блок проходится за один макрошаг
+ */
+template <typename State, typename Symbol>
+class MacroMachineEngine : public IExecutionEngine<State, Symbol> {
+private:
+    int block_size_;
+
+    struct MacroKey {
+        State state;
+        int offset;
+        std::vector<Symbol> cells;
+
+        bool operator==(const MacroKey& other) const {
+            return offset == other.offset && state == other.state && cells == other.cells;
+        }
+    };
+
+    struct MacroKeyHasher {
+        size_t operator()(const MacroKey& key) const {
+            size_t h = std::hash<State>{}(key.state) * 31 + static_cast<size_t>(key.offset);
+            for (const auto& symbol : key.cells) {
+                h = h * 1099511628211ULL ^ std::hash<Symbol>{}(symbol);
+            }
+            return h;
+        }
+    };
+
+    /**
+     * Итог прохода по блоку
+     */
+    struct MacroTransition {
+        std::vector<Symbol> cells;
+        State state;
+        int exit_offset;          // -1 / block_size - вышли влево / вправо, иначе остановка внутри
+        size_t steps;
+        int min_offset;
+        int max_offset;
+        ExecutionResult stop;     // ACCEPTED / REJECTED, если остановились внутри блока; иначе TIMEOUT
+    };
+
+public:
+    explicit MacroMachineEngine(int block_size = 4) : block_size_(std::max(1, block_size)) {}
+
+    std::string GetName() const override {
+        return "macro-machine";
+    }
+
+    EngineOutcome<State, Symbol> Execute(const MachineDefinition<State, Symbol>& machine,
+                                         const std::vector<Symbol>& input,
+                                         size_t max_steps,
+                                         const std::atomic<bool>& cancel) const override {
+        TransitionManager<State, Symbol> rules;
+        for (const auto& rule : machine.rules) {
+            rules.AddRule(rule);
+        }
+        StateManager<State> states(machine.initial_state);
+        for (const auto& state : machine.final_states) {
+            states.AddFinalState(state);
+        }
+
+        const Symbol& blank = machine.blank_symbol;
+        const int k = block_size_;
+
+        // Блоки ленты: индекс блока b хранится в blocks[b + block_origin]
+        std::vector<std::vector<Symbol>> blocks;
+        long long block_origin = 1;
+        long long input_blocks = static_cast<long long>((input.size() + static_cast<size_t>(k) - 1) / static_cast<size_t>(k));
+        blocks.assign(static_cast<size_t>(input_blocks + 2), std::vector<Symbol>(static_cast<size_t>(k), blank));
+        for (size_t i = 0; i < input.size(); ++i) {
+            blocks[static_cast<size_t>(block_origin) + i / static_cast<size_t>(k)][i % static_cast<size_t>(k)] = input[i];
+        }
+        auto block_at = [&](long long b) -> std::vector<Symbol>& {
+            while (b + block_origin < 0) {
+                size_t grow = std::max<size_t>(blocks.size(), 1);
+                blocks.insert(blocks.begin(), grow, std::vector<Symbol>(static_cast<size_t>(k), blank));
+                block_origin += static_cast<long long>(grow);
+            }
+            while (b + block_origin >= static_cast<long long>(blocks.size())) {
+                blocks.resize(blocks.size() * 2, std::vector<Symbol>(static_cast<size_t>(k), blank));
+            }
+            return blocks[static_cast<size_t>(b + block_origin)];
+        };
+
+        std::unordered_map<MacroKey, MacroTransition, MacroKeyHasher> cache;
+
+        // Проход по блоку шаг за шагом не более budget шагов
+        auto simulate_block = [&](const State& state, int offset, const std::vector<Symbol>& cells, size_t budget) {
+            MacroTransition t{cells, state, offset, 0, offset, offset, ExecutionResult::TIMEOUT};
+            while (true) {
+                if (states.IsFinalState(t.state)) {
+                    t.stop = ExecutionResult::ACCEPTED;
+                    return t;
+                }
+                if (t.steps >= budget) {
+                    return t;   // TIMEOUT внутри блока
+                }
+                auto rule = rules.FindRule(t.state, t.cells[static_cast<size_t>(t.exit_offset)]);
+                if (!rule) {
+                    t.stop = ExecutionResult::REJECTED;
+                    return t;
+                }
+                t.cells[static_cast<size_t>(t.exit_offset)] = rule->write_symbol;
+                t.state = rule->to_state;
+                t.exit_offset += static_cast<int>(rule->direction);
+                t.steps++;
+                t.min_offset = std::min(t.min_offset, t.exit_offset);
+                t.max_offset = std::max(t.max_offset, t.exit_offset);
+                if (t.exit_offset < 0 || t.exit_offset >= k) {
+                    return t;   // Вышли из блока
+                }
+            }
+        };
+
+        auto floor_div = [k](long long position) {
+            return position >= 0 ? position / k : -((-position + k - 1) / k);
+        };
+
+        long long head = 0;
+        long long min_head = 0;
+        long long max_head = 0;
+        size_t steps = 0;
+        size_t iterations = 0;
+        EngineOutcome<State, Symbol> outcome;
+        ProfiledRegion profiled(ProfileStateId(machine.initial_state), 0);
+        bool profiling = SamplingProfiler::IsEnabled();
+
+        while (true) {
+            if (++iterations % this->CANCEL_CHECK_INTERVAL == 0 && cancel.load(std::memory_order_relaxed)) {
+                outcome.cancelled = true;
+                return outcome;
+            }
+
+            long long b = floor_div(head);
+            int offset = static_cast<int>(head - b * k);
+            auto& block = block_at(b);
+            size_t remaining = max_steps - steps;
+
+            MacroKey key{states.GetCurrentState(), offset, block};
+            auto cached = cache.find(key);
+            MacroTransition transition;
+            if (cached != cache.end() && cached->second.steps <= remaining) {
+                transition = cached->second;
+            } else {
+                transition = simulate_block(key.state, offset, block, remaining);
+                bool left_block = transition.exit_offset < 0 || transition.exit_offset >= k;
+                if (left_block || transition.stop != ExecutionResult::TIMEOUT) {
+                    cache.emplace(std::move(key), transition);
+                }
+            }
+
+            block = transition.cells;
+            states.SetCurrentState(transition.state);
+            steps += transition.steps;
+            min_head = std::min(min_head, b * k + transition.min_offset);
+            max_head = std::max(max_head, b * k + transition.max_offset);
+            head = b * k + transition.exit_offset;
+            if (profiling) {
+                SamplingProfiler::Publish(ProfileStateId(transition.state), head);
+            }
+
+            if (transition.stop != ExecutionResult::TIMEOUT) {
+                outcome.result = transition.stop;
+                break;
+            }
+            bool left_block = transition.exit_offset < 0 || transition.exit_offset >= k;
+            if (!left_block || steps >= max_steps) {
+                // Бюджет исчерпан (внутри блока или ровно на выходе); при выходе
+                // из блока конечное состояние проверяется раньше лимита, как в Run
+                if (left_block && states.IsInFinalState()) {
+                    outcome.result = ExecutionResult::ACCEPTED;
+                } else {
+                    outcome.result = ExecutionResult::TIMEOUT;
+                }
+                break;
+            }
+        }
+
+        outcome.steps = steps;
+        outcome.final_state = states.GetCurrentState();
+        outcome.head_position = static_cast<int>(head);
+        auto [start, end] = this->OutputRange(input.size(), static_cast<int>(min_head), static_cast<int>(max_head));
+        outcome.tape_start = start;
+        outcome.tape.resize(static_cast<size_t>(end - start + 1), blank);
+        for (int position = start; position <= end; ++position) {
+            long long b = floor_div(position);
+            outcome.tape[static_cast<size_t>(position - start)] =
+                block_at(b)[static_cast<size_t>(position - b * k)];
+        }
+        return outcome;
+    }
+};
@@ -1,8 +1,16 @@
 #pragma once
 
+#include "MappedFile.h"
+
 #include <stdexcept>
 #include <optional>
 #include <functional>
+#include <memory>
+#include <vector>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
 
 /**
  * Базовый интерфейс для генератора элементов
@@ -99,6 +107,10 @@ public:
     std::optional<T> TryGetNext() override {
         return constant_value_;
     }
+    
+    const T& GetValue() const {
+        return constant_value_;
+    }
 };
 
 /**
@@ -188,6 +200,242 @@ public:
     size_t GetInitialDataSize() const {
         return sequence_gen_.GetDataSize();
     }
+    
+    /**
+     * Индекс, начиная с которого генератор выдаёт только пустой символ.
+     * LazySeq использует его, чтобы не материализовывать пустой хвост ленты
+     */
+    size_t ConstantTailStart() const {
+        return sequence_gen_.GetDataSize();
+    }
+    
+    /**
+     * Значение бесконечного хвоста (пустой символ)
+     */
+    const T& ConstantTailValue() const {
+        return constant_gen_.GetValue();
+    }
+};
+
+/**
+ * Генератор, склеивающий несколько источников без копирования
+ * Источники: векторы (разделяемое владение), произвольные участки памяти,
+ * отображённые в память файлы и другие генераторы; после всех источников
+ * может выдаваться бесконечное заполнение. NextBatch() отдаёт участок прямо
+ * из текущего источника, так что LazySeq материализует блоки без
+ * промежуточной склейки. Генераторы-источники принадлежат ConcatGenerator,
+ * поэтому он только перемещается
+ */
+template <typename T>
+class ConcatGenerator : public IGenerator<T> {
+public:
+    static constexpr size_t UNBOUNDED = std::numeric_limits<size_t>::max();
+
+private:
+    struct Part {
+        const T* data = nullptr;                   // Непрерывный источник
+        size_t size = 0;                           // Число элементов (UNBOUNDED - до исчерпания генератора)
+        std::shared_ptr<const void> owner;         // Держит вектор или отображение файла
+        std::unique_ptr<IGenerator<T>> generator;  // Источник-генератор
+    };
+
+    static constexpr size_t FILL_BATCH = 4096;
+
+    std::vector<Part> parts_;
+    size_t part_index_ = 0;
+    size_t offset_ = 0;                // Позиция внутри текущего источника
+    bool has_fill_ = false;
+    T fill_value_{};
+    size_t fill_start_ = 0;            // Суммарная длина источников (UNBOUNDED, если есть генераторы)
+    std::vector<T> buffer_;            // Пакет из генератора или заполнения
+
+    ConcatGenerator& AddPart(Part part) {
+        if (!part.data) {
+            fill_start_ = UNBOUNDED;
+        } else if (fill_start_ != UNBOUNDED) {
+            fill_start_ += part.size;
+        }
+        parts_.push_back(std::move(part));
+        return *this;
+    }
+
+    /**
+     * Перейти к источнику, в котором ещё есть элементы
+     * @return false если источники кончились
+     */
+    bool SkipExhausted() {
+        while (part_index_ < parts_.size()) {
+            const Part& part = parts_[part_index_];
+            if (offset_ < part.size && (part.data || part.generator->HasNext())) {
+                return true;
+            }
+            part_index_++;
+            offset_ = 0;
+        }
+        return false;
+    }
+
+public:
+    ConcatGenerator() = default;
+
+    /**
+     * Вектор, передаваемый во владение (перемещается, не копируется)
+     */
+    ConcatGenerator& AddVector(std::vector<T>&& data) {
+        return AddVector(std::make_shared<const std::vector<T>>(std::move(data)));
+    }
+
+    /**
+     * Вектор с разделяемым владением
+     */
+    ConcatGenerator& AddVector(std::shared_ptr<const std::vector<T>> data) {
+        Part part;
+        part.data = data->data();
+        part.size = data->size();
+        part.owner = std::move(data);
+        return AddPart(std::move(part));
+    }
+
+    /**
+     * Участок памяти; должен жить дольше генератора
+     */
+    ConcatGenerator& AddSpan(const T* data, size_t size) {
+        Part part;
+        part.data = data;
+        part.size = size;
+        return AddPart(std::move(part));
+    }
+
+    /**
+     * Содержимое отображённого файла как массив T
+     * @param offset_bytes Смещение от начала файла (кратно выравниванию T)
+     * @param count Число элементов (по умолчанию до конца файла)
+     */
+    ConcatGenerator& AddFile(std::shared_ptr<const MappedFile> file, size_t offset_bytes = 0, size_t count = UNBOUNDED) {
+        static_assert(std::is_trivially_copyable_v<T>, "Из файла читаются только тривиально копируемые элементы");
+        if (offset_bytes > file->Size() || offset_bytes % alignof(T) != 0) {
+            throw std::invalid_argument("Неверное смещение в отображённом файле");
+        }
+        size_t available = (file->Size() - offset_bytes) / sizeof(T);
+        Part part;
+        part.data = reinterpret_cast<const T*>(file->Data() + offset_bytes);
+        part.size = std::min(count, available);
+        part.owner = std::move(file);
+        return AddPart(std::move(part));
+    }
+
+    /**
+     * Не более count элементов другого генератора
+     */
+    ConcatGenerator& AddGenerator(std::unique_ptr<IGenerator<T>> generator, size_t count = UNBOUNDED) {
+        Part part;
+        part.size = count;
+        part.generator = std::move(generator);
+        return AddPart(std::move(part));
+    }
+
+    /**
+     * Значение, выдаваемое бесконечно после всех источников
+     */
+    ConcatGenerator& SetFill(const T& value) {
+        has_fill_ = true;
+        fill_value_ = value;
+        return *this;
+    }
+
+    T GetNext() override {
+        auto next = TryGetNext();
+        if (!next) {
+            throw std::out_of_range("Нет больше элементов в генераторе");
+        }
+        return std::move(*next);
+    }
+
+    bool HasNext() const override {
+        if (has_fill_) {
+            return true;
+        }
+        for (size_t i = part_index_; i < parts_.size(); ++i) {
+            size_t offset = (i == part_index_) ? offset_ : 0;
+            if (offset < parts_[i].size && (parts_[i].data || parts_[i].generator->HasNext())) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::optional<T> TryGetNext() override {
+        while (SkipExhausted()) {
+            Part& part = parts_[part_index_];
+            if (part.data) {
+                return part.data[offset_++];
+            }
+            if (auto value = part.generator->TryGetNext()) {
+                offset_++;
+                return value;
+            }
+            part.size = offset_;   // Генератор иссяк раньше заявленной длины
+        }
+        if (has_fill_) {
+            return fill_value_;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * Следующий пакет не более чем из max_count элементов
+     * Для непрерывных источников указывает прямо в источник, иначе - во
+     * внутренний буфер; действителен до следующего вызова
+     * @return Пара (указатель, длина); длина 0 - элементы кончились
+     */
+    std::pair<const T*, size_t> NextBatch(size_t max_count) {
+        while (max_count > 0 && SkipExhausted()) {
+            Part& part = parts_[part_index_];
+            size_t count = std::min(max_count, part.size - offset_);
+            if (part.data) {
+                const T* begin = part.data + offset_;
+                offset_ += count;
+                return {begin, count};
+            }
+            buffer_.clear();
+            while (buffer_.size() < count) {
+                auto value = part.generator->TryGetNext();
+                if (!value) {
+                    part.size = offset_;
+                    break;
+                }
+                buffer_.push_back(std::move(*value));
+                offset_++;
+            }
+            if (!buffer_.empty()) {
+                return {buffer_.data(), buffer_.size()};
+            }
+        }
+        if (has_fill_ && max_count > 0) {
+            buffer_.assign(std::min(max_count, FILL_BATCH), fill_value_);
+            return {buffer_.data(), buffer_.size()};
+        }
+        return {nullptr, 0};
+    }
+
+    /**
+     * Индекс начала заполнения; известен, только если все источники
+     * непрерывные и заполнение задано (иначе UNBOUNDED)
+     */
+    size_t ConstantTailStart() const {
+        return has_fill_ ? fill_start_ : UNBOUNDED;
+    }
+
+    const T& ConstantTailValue() const {
+        return fill_value_;
+    }
+
+    /**
+     * Число источников
+     */
+    size_t GetPartsCount() const {
+        return parts_.size();
+    }
 };
 
 /**
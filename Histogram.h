@@ -0,0 +1,325 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * Раскладка корзин лог-линейной гистограммы (как в HdrHistogram)
+ * Значения меньше 2^bits лежат в отдельных корзинах; выше каждая степень
+ * двойки делится на 2^(bits-1) равных корзин, так что относительная
+ * погрешность не превышает 2^-(bits-1)
+ */
+class HistogramLayout {
+private:
+    unsigned bits_;
+    uint64_t sub_buckets_;   // 2^bits
+    uint64_t half_;          // 2^(bits-1)
+
+    static unsigned HighestBit(uint64_t value) {
+        return 63u - static_cast<unsigned>(__builtin_clzll(value));
+    }
+
+public:
+    explicit HistogramLayout(unsigned significant_bits) : bits_(significant_bits) {
+        if (bits_ < 1 || bits_ > 16) {
+            throw std::invalid_argument("Точность гистограммы должна быть от 1 до 16 бит");
+        }
+        sub_buckets_ = uint64_t{1} << bits_;
+        half_ = sub_buckets_ >> 1;
+    }
+
+    unsigned GetSignificantBits() const {
+        return bits_;
+    }
+
+    size_t GetBucketsCount() const {
+        return static_cast<size_t>(sub_buckets_ + (64 - bits_) * half_);
+    }
+
+    size_t IndexOf(uint64_t value) const {
+        if (value < sub_buckets_) {
+            return static_cast<size_t>(value);
+        }
+        unsigned shift = HighestBit(value) - (bits_ - 1);
+        uint64_t top = value >> shift;
+        return static_cast<size_t>(sub_buckets_ + (shift - 1) * half_ + (top - half_));
+    }
+
+    /**
+     * Наименьшее значение корзины
+     */
+    uint64_t LowestValue(size_t index) const {
+        if (index < sub_buckets_) {
+            return index;
+        }
+        uint64_t k = index - sub_buckets_;
+        unsigned shift = static_cast<unsigned>(k / half_) + 1;
+        return (half_ + k % half_) << shift;
+    }
+
+    /**
+     * Наибольшее значение корзины
+     */
+    uint64_t HighestValue(size_t index) const {
+        if (index < sub_buckets_) {
+            return index;
+        }
+        uint64_t k = index - sub_buckets_;
+        unsigned shift = static_cast<unsigned>(k / half_) + 1;
+        uint64_t top = half_ + k % half_;
+        return ((top + 1) << shift) - 1;   // Для последней корзины переполнение даёт 2^64 - 1
+    }
+
+    bool operator==(const HistogramLayout& other) const {
+        return bits_ == other.bits_;
+    }
+};
+
+/**
+ * Лог-линейная гистограмма значений (задержек, числа шагов)
+ * Запись за O(1), размер не зависит от числа записей, гистограммы
+ * одинаковой точности складываются без потерь. Не потокобезопасна -
+ * для записи из нескольких потоков см. ConcurrentHistogram
+ */
+class HdrHistogram {
+private:
+    HistogramLayout layout_;
+    std::vector<uint64_t> counts_;
+    uint64_t total_count_ = 0;
+    uint64_t min_ = std::numeric_limits<uint64_t>::max();
+    uint64_t max_ = 0;
+    long double sum_ = 0;
+
+public:
+    static constexpr unsigned DEFAULT_SIGNIFICANT_BITS = 7;
+
+    HdrHistogram() : HdrHistogram(DEFAULT_SIGNIFICANT_BITS) {}
+
+    /**
+     * @param significant_bits Точность: относительная погрешность 2^-(bits-1)
+     */
+    explicit HdrHistogram(unsigned significant_bits)
+        : layout_(significant_bits), counts_(layout_.GetBucketsCount(), 0) {}
+
+    void Record(uint64_t value, uint64_t count = 1) {
+        if (count == 0) return;
+        counts_[layout_.IndexOf(value)] += count;
+        total_count_ += count;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+        sum_ += static_cast<long double>(value) * count;
+    }
+
+    /**
+     * Добавить записи другой гистограммы той же точности
+     */
+    void Merge(const HdrHistogram& other) {
+        if (!(layout_ == other.layout_)) {
+            throw std::invalid_argument("Складываются только гистограммы одинаковой точности");
+        }
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        total_count_ += other.total_count_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        sum_ += other.sum_;
+    }
+
+    /**
+     * Собрать гистограмму из сырых счётчиков корзин (для ConcurrentHistogram)
+     */
+    void AddBucketCounts(const std::vector<uint64_t>& counts, uint64_t min, uint64_t max, long double sum) {
+        for (size_t i = 0; i < counts_.size() && i < counts.size(); ++i) {
+            counts_[i] += counts[i];
+            total_count_ += counts[i];
+        }
+        min_ = std::min(min_, min);
+        max_ = std::max(max_, max);
+        sum_ += sum;
+    }
+
+    void Reset() {
+        std::fill(counts_.begin(), counts_.end(), 0);
+        total_count_ = 0;
+        min_ = std::numeric_limits<uint64_t>::max();
+        max_ = 0;
+        sum_ = 0;
+    }
+
+    uint64_t GetTotalCount() const {
+        return total_count_;
+    }
+
+    uint64_t GetMin() const {
+        return total_count_ ? min_ : 0;
+    }
+
+    uint64_t GetMax() const {
+        return max_;
+    }
+
+    double GetMean() const {
+        return total_count_ ? static_cast<double>(sum_ / total_count_) : 0.0;
+    }
+
+    /**
+     * Значение, не меньше которого percentile процентов записей
+     * (верхняя граница корзины, но не больше максимума)
+     */
+    uint64_t GetValueAtPercentile(double percentile) const {
+        if (total_count_ == 0) return 0;
+        if (percentile <= 0.0) return GetMin();
+        percentile = std::min(percentile, 100.0);
+        uint64_t target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(total_count_)));
+        target = std::max<uint64_t>(1, std::min(target, total_count_));
+
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            cumulative += counts_[i];
+            if (cumulative >= target) {
+                return std::max(GetMin(), std::min(layout_.HighestValue(i), max_));
+            }
+        }
+        return max_;
+    }
+
+    /**
+     * Доля записей (в процентах) со значением не больше value
+     */
+    double GetPercentileOfValue(uint64_t value) const {
+        if (total_count_ == 0) return 100.0;
+        size_t last = layout_.IndexOf(value);
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i <= last; ++i) {
+            cumulative += counts_[i];
+        }
+        return 100.0 * static_cast<double>(cumulative) / static_cast<double>(total_count_);
+    }
+
+    const HistogramLayout& GetLayout() const {
+        return layout_;
+    }
+
+    /**
+     * Краткая сводка: число, минимум, среднее, перцентили, максимум
+     * @param unit Подпись единицы измерения
+     */
+    void PrintSummary(std::ostream& out, const std::string& unit = "") const {
+        std::string suffix = unit.empty() ? "" : " " + unit;
+        out << "n=" << total_count_
+            << " min=" << GetMin() << suffix
+            << " mean=" << std::fixed << std::setprecision(1) << GetMean() << std::defaultfloat << suffix
+            << " p50=" << GetValueAtPercentile(50) << suffix
+            << " p90=" << GetValueAtPercentile(90) << suffix
+            << " p99=" << GetValueAtPercentile(99) << suffix
+            << " p99.9=" << GetValueAtPercentile(99.9) << suffix
+            << " max=" << GetMax() << suffix << std::endl;
+    }
+
+    /**
+     * Выгрузить непустые корзины в CSV: нижняя и верхняя граница, число
+     * записей, накопленный процент
+     */
+    void ExportCsv(std::ostream& out) const {
+        out << "low,high,count,cumulative_percent" << std::endl;
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            if (counts_[i] == 0) continue;
+            cumulative += counts_[i];
+            out << layout_.LowestValue(i) << ',' << layout_.HighestValue(i) << ',' << counts_[i] << ','
+                << std::fixed << std::setprecision(4)
+                << 100.0 * static_cast<double>(cumulative) / static_cast<double>(total_count_)
+                << std::defaultfloat << std::endl;
+        }
+    }
+};
+
+/**
+ * Гистограмма с записью из нескольких потоков без блокировок
+ * Каждый поток получает свой Recorder (один раз, под мьютексом) и пишет в
+ * свои счётчики relaxed-атомиками; у каждого счётчика один писатель.
+ * Snapshot() складывает счётчики всех потоков в HdrHistogram и может
+ * вызываться во время записи
+ */
+class ConcurrentHistogram {
+public:
+    class Recorder {
+    private:
+        const HistogramLayout& layout_;
+        std::unique_ptr<std::atomic<uint64_t>[]> counts_;
+        std::atomic<uint64_t> min_{std::numeric_limits<uint64_t>::max()};
+        std::atomic<uint64_t> max_{0};
+        std::atomic<uint64_t> sum_{0};   // По модулю 2^64; для средних значений с запасом
+
+        friend class ConcurrentHistogram;
+
+        static void Bump(std::atomic<uint64_t>& counter, uint64_t delta) {
+            counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+        }
+
+    public:
+        explicit Recorder(const HistogramLayout& layout)
+            : layout_(layout), counts_(new std::atomic<uint64_t>[layout.GetBucketsCount()]) {
+            for (size_t i = 0; i < layout_.GetBucketsCount(); ++i) {
+                counts_[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        void Record(uint64_t value) {
+            Bump(counts_[layout_.IndexOf(value)], 1);
+            Bump(sum_, value);
+            if (value < min_.load(std::memory_order_relaxed)) min_.store(value, std::memory_order_relaxed);
+            if (value > max_.load(std::memory_order_relaxed)) max_.store(value, std::memory_order_relaxed);
+        }
+    };
+
+private:
+    HistogramLayout layout_;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Recorder>> recorders_;
+
+public:
+    explicit ConcurrentHistogram(unsigned significant_bits = HdrHistogram::DEFAULT_SIGNIFICANT_BITS)
+        : layout_(significant_bits) {}
+
+    ConcurrentHistogram(const ConcurrentHistogram&) = delete;
+    ConcurrentHistogram& operator=(const ConcurrentHistogram&) = delete;
+
+    /**
+     * Счётчики для одного потока; живут, пока жива гистограмма
+     */
+    Recorder& AcquireRecorder() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        recorders_.push_back(std::make_unique<Recorder>(layout_));
+        return *recorders_.back();
+    }
+
+    /**
+     * Сумма записей всех потоков на данный момент
+     */
+    HdrHistogram Snapshot() const {
+        HdrHistogram result(layout_.GetSignificantBits());
+        std::vector<uint64_t> counts(layout_.GetBucketsCount());
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& recorder : recorders_) {
+            for (size_t i = 0; i < counts.size(); ++i) {
+                counts[i] = recorder->counts_[i].load(std::memory_order_relaxed);
+            }
+            result.AddBucketCounts(counts, recorder->min_.load(std::memory_order_relaxed),
+                                   recorder->max_.load(std::memory_order_relaxed),
+                                   static_cast<long double>(recorder->sum_.load(std::memory_order_relaxed)));
+        }
+        return result;
+    }
+};
@@ -0,0 +1,602 @@
+#pragma once
+
+#include "ExecutionEngines.h"
+
+#include <atomic>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+#include <initializer_list>
+
+#if defined(__x86_64__) && (defined(__unix__) || defined(__APPLE__))
+#define JIT_ENGINE_USE_X86_64 1
+#include <unistd.h>
+#include <sys/mman.h>
+#else
+#define JIT_ENGINE_USE_X86_64 0
+#endif
+
+namespace jit_detail {
+
+/**
+ * Состояние исполнения, которым обмениваются C++ и машинный код
+ * Смещения полей зашиты в пролог и эпилог сгенерированного кода
+ */
+struct Context {
+    uint8_t* head;       // Ячейка под головкой
+    uint8_t* low;        // Первая ячейка буфера ленты
+    uint8_t* high;       // За последней ячейкой буфера
+    uint8_t* min_head;   // Крайние посещённые ячейки
+    uint8_t* max_head;
+    uint64_t budget;     // Сколько шагов ещё можно сделать
+    uint64_t state;      // Номер состояния
+    uint64_t exit;       // Причина выхода (Exit)
+};
+
+static_assert(offsetof(Context, head) == 0 && offsetof(Context, low) == 8 && offsetof(Context, high) == 16 &&
+              offsetof(Context, min_head) == 24 && offsetof(Context, max_head) == 32 &&
+              offsetof(Context, budget) == 40 && offsetof(Context, state) == 48 && offsetof(Context, exit) == 56,
+              "Раскладка Context зашита в машинный код");
+
+enum Exit : uint32_t {
+    EXIT_ACCEPT = 0,   // Пришли в конечное состояние
+    EXIT_REJECT = 1,   // Нет правила для символа под головкой
+    EXIT_BUDGET = 2,   // Бюджет шагов исчерпан
+    EXIT_GROW = 3      // Головка вышла за буфер ленты (шаг уже сделан)
+};
+
+/**
+ * Минимальный ассемблер x86-64: байты, метки и переходы rel32
+ */
+class Assembler {
+private:
+    static constexpr size_t UNBOUND = static_cast<size_t>(-1);
+
+    std::vector<uint8_t> code_;
+    std::vector<size_t> labels_;
+    std::vector<std::pair<size_t, size_t>> fixups_;   // (позиция rel32, метка)
+
+public:
+    enum Condition : uint8_t {
+        BELOW = 0x82,
+        ABOVE_OR_EQUAL = 0x83,
+        NOT_EQUAL = 0x85,
+        ABOVE = 0x87
+    };
+
+    size_t NewLabel() {
+        labels_.push_back(UNBOUND);
+        return labels_.size() - 1;
+    }
+
+    void Bind(size_t label) {
+        labels_[label] = code_.size();
+    }
+
+    void Emit(std::initializer_list<uint8_t> bytes) {
+        code_.insert(code_.end(), bytes);
+    }
+
+    void Imm32(uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            code_.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    /**
+     * Смещение rel32 до метки, отсчитываемое от конца инструкции
+     * (rel32 должен быть последним полем инструкции)
+     */
+    void Rel32(size_t label) {
+        fixups_.emplace_back(code_.size(), label);
+        Imm32(0);
+    }
+
+    void Jump(size_t label) {
+        Emit({0xE9});
+        Rel32(label);
+    }
+
+    void JumpIf(Condition condition, size_t label) {
+        Emit({0x0F, condition});
+        Rel32(label);
+    }
+
+    void Align(size_t alignment) {
+        while (code_.size() % alignment != 0) {
+            code_.push_back(0xCC);
+        }
+    }
+
+    /**
+     * 8-байтовый слот со смещением метки от начала кода
+     * (после загрузки к нему прибавляется адрес кода)
+     */
+    size_t AddressSlot(size_t label) {
+        size_t slot = code_.size();
+        uint64_t offset = labels_[label];
+        for (int i = 0; i < 8; ++i) {
+            code_.push_back(static_cast<uint8_t>(offset >> (8 * i)));
+        }
+        return slot;
+    }
+
+    std::vector<uint8_t> Finish() {
+        for (const auto& [position, label] : fixups_) {
+            int32_t rel = static_cast<int32_t>(static_cast<int64_t>(labels_[label]) -
+                                               static_cast<int64_t>(position + 4));
+            std::memcpy(&code_[position], &rel, sizeof(rel));
+        }
+        return std::move(code_);
+    }
+};
+
+/**
+ * Исполняемая область памяти
+ * Код копируется в страницы с правами чтения и записи, затем права
+ * меняются на чтение и исполнение (W^X: запись и исполнение не совмещаются)
+ */
+class ExecutableMemory {
+private:
+    void* data_ = nullptr;
+    size_t size_ = 0;
+
+public:
+    ExecutableMemory() = default;
+    ExecutableMemory(const ExecutableMemory&) = delete;
+    ExecutableMemory& operator=(const ExecutableMemory&) = delete;
+
+    ~ExecutableMemory() {
+#if JIT_ENGINE_USE_X86_64
+        if (data_) {
+            ::munmap(data_, size_);
+        }
+#endif
+    }
+
+    /**
+     * Загрузить код; к слотам адресов прибавляется адрес начала кода
+     * @return false, если система не выдала исполняемую память
+     */
+    bool Load(std::vector<uint8_t> code, const std::vector<size_t>& address_slots) {
+#if JIT_ENGINE_USE_X86_64
+        size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        size_t size = (code.size() + page - 1) / page * page;
+        void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (data == MAP_FAILED) {
+            return false;
+        }
+        uint64_t base = reinterpret_cast<uintptr_t>(data);
+        for (size_t slot : address_slots) {
+            uint64_t address;
+            std::memcpy(&address, &code[slot], sizeof(address));
+            address += base;
+            std::memcpy(&code[slot], &address, sizeof(address));
+        }
+        std::memcpy(data, code.data(), code.size());
+        if (::mprotect(data, size, PROT_READ | PROT_EXEC) != 0) {
+            ::munmap(data, size);
+            return false;
+        }
+        data_ = data;
+        size_ = size;
+        return true;
+#else
+        (void)code;
+        (void)address_slots;
+        return false;
+#endif
+    }
+
+    const void* GetData() const {
+        return data_;
+    }
+
+    size_t GetSize() const {
+        return size_;
+    }
+};
+
+}  // namespace jit_detail
+
+template <typename State, typename Symbol>
+class JitEngine;
+
+/**
+ * Машина, скомпилированная в машинный код x86-64
+ * Состояния и символы нумеруются плотно, ячейка ленты - один байт с номером
+ * символа. Каждому состоянию соответствует блок кода: проверка бюджета шагов,
+ * чтение ячейки, цепочка сравнений с символами правил, запись, сдвиг
+ * указателя головки и переход на блок следующего состояния. В C++ код
+ * возвращается только при остановке, исчерпании бюджета и выходе головки
+ * за буфер ленты.
+ * Символы входа, которых нет в правилах, получают общий номер FOREIGN_CODE:
+ * правил для них нет, поэтому такие ячейки никогда не перезаписываются, и
+ * исходный символ восстанавливается по входу.
+ * Компиляция не выполняется (IsCompiled() == false) вне x86-64/POSIX, при
+ * алфавите больше 255 символов или если не удалось получить исполняемую память
+ */
+template <typename State, typename Symbol>
+class JitProgram {
+private:
+    static constexpr uint8_t FOREIGN_CODE = 255;
+
+    using Entry = void (*)(jit_detail::Context*);
+
+    MachineDefinition<State, Symbol> definition_;
+    std::vector<State> states_;
+    std::unordered_map<State, uint32_t> state_index_;
+    std::vector<Symbol> alphabet_;
+    std::unordered_map<Symbol, uint8_t> symbol_code_;
+    jit_detail::ExecutableMemory memory_;
+    Entry entry_ = nullptr;
+
+    friend class JitEngine<State, Symbol>;
+
+    uint32_t StateIndex(const State& state) {
+        auto [it, inserted] = state_index_.emplace(state, static_cast<uint32_t>(states_.size()));
+        if (inserted) {
+            states_.push_back(state);
+        }
+        return it->second;
+    }
+
+    /**
+     * Сгенерировать код; rules - по одному правилу на (состояние, символ)
+     */
+    std::vector<uint8_t> Generate(const std::vector<TransitionRule<State, Symbol>>& rules,
+                                  const std::vector<bool>& is_final,
+                                  std::vector<size_t>& address_slots) const {
+        using jit_detail::Assembler;
+        Assembler as;
+        const size_t n = states_.size();
+        const size_t NONE = static_cast<size_t>(-1);
+
+        std::vector<std::vector<const TransitionRule<State, Symbol>*>> by_state(n);
+        for (const auto& rule : rules) {
+            by_state[state_index_.at(rule.from_state)].push_back(&rule);
+        }
+
+        std::vector<size_t> blocks(n);
+        for (auto& label : blocks) {
+            label = as.NewLabel();
+        }
+        std::vector<size_t> budget_exits(n, NONE);
+        std::vector<size_t> left_exits(n, NONE);    // Головка левее посещённых ячеек
+        std::vector<size_t> right_exits(n, NONE);   // Головка правее посещённых ячеек
+        std::vector<size_t> grow_exits(n, NONE);
+        auto lazy = [&](std::vector<size_t>& labels, size_t state) {
+            if (labels[state] == NONE) labels[state] = as.NewLabel();
+            return labels[state];
+        };
+        size_t epilogue = as.NewLabel();
+        size_t table = as.NewLabel();
+
+        auto exit_with = [&](size_t state, uint32_t reason) {
+            as.Emit({0xB9});                 // mov ecx, state
+            as.Imm32(static_cast<uint32_t>(state));
+            as.Emit({0xB8});                 // mov eax, reason
+            as.Imm32(reason);
+            as.Jump(epilogue);
+        };
+
+        // Пролог: регистры из Context, переход на блок текущего состояния
+        as.Emit({0x48, 0x8B, 0x37});         // mov rsi, [rdi]        ; головка
+        as.Emit({0x4C, 0x8B, 0x47, 0x08});   // mov r8, [rdi + 8]     ; начало буфера
+        as.Emit({0x4C, 0x8B, 0x4F, 0x10});   // mov r9, [rdi + 16]    ; конец буфера
+        as.Emit({0x4C, 0x8B, 0x5F, 0x18});   // mov r11, [rdi + 24]   ; минимум головки
+        as.Emit({0x48, 0x8B, 0x57, 0x20});   // mov rdx, [rdi + 32]   ; максимум головки
+        as.Emit({0x4C, 0x8B, 0x57, 0x28});   // mov r10, [rdi + 40]   ; бюджет
+        as.Emit({0x48, 0x8B, 0x4F, 0x30});   // mov rcx, [rdi + 48]   ; состояние
+        as.Emit({0x48, 0x8D, 0x05});         // lea rax, [rip + table]
+        as.Rel32(table);
+        as.Emit({0xFF, 0x24, 0xC8});         // jmp [rax + rcx * 8]
+
+        for (size_t state = 0; state < n; ++state) {
+            as.Bind(blocks[state]);
+            if (is_final[state]) {
+                exit_with(state, jit_detail::EXIT_ACCEPT);
+                continue;
+            }
+
+            as.Emit({0x49, 0x83, 0xEA, 0x01});   // sub r10, 1
+            as.JumpIf(Assembler::BELOW, lazy(budget_exits, state));
+            as.Emit({0x0F, 0xB6, 0x06});         // movzx eax, byte [rsi]
+
+            for (const auto* rule : by_state[state]) {
+                uint8_t read = symbol_code_.at(rule->read_symbol);
+                uint8_t write = symbol_code_.at(rule->write_symbol);
+                size_t target = state_index_.at(rule->to_state);
+                size_t next_rule = as.NewLabel();
+
+                as.Emit({0x3C, read});           // cmp al, read
+                as.JumpIf(Assembler::NOT_EQUAL, next_rule);
+                if (write != read) {
+                    as.Emit({0xC6, 0x06, write});   // mov byte [rsi], write
+                }
+                if (rule->direction == Direction::LEFT) {
+                    as.Emit({0x48, 0xFF, 0xCE});    // dec rsi
+                    as.Emit({0x4C, 0x39, 0xDE});    // cmp rsi, r11
+                    as.JumpIf(Assembler::BELOW, lazy(left_exits, target));
+                } else if (rule->direction == Direction::RIGHT) {
+                    as.Emit({0x48, 0xFF, 0xC6});    // inc rsi
+                    as.Emit({0x48, 0x39, 0xD6});    // cmp rsi, rdx
+                    as.JumpIf(Assembler::ABOVE, lazy(right_exits, target));
+                }
+                as.Jump(blocks[target]);
+                as.Bind(next_rule);
+            }
+
+            // Правила нет: шаг не сделан, бюджет возвращается
+            as.Emit({0x49, 0x83, 0xC2, 0x01});   // add r10, 1
+            exit_with(state, jit_detail::EXIT_REJECT);
+        }
+
+        // Редкие пути: новые крайние ячейки, рост буфера, конец бюджета
+        for (size_t state = 0; state < n; ++state) {
+            if (left_exits[state] != NONE) {
+                as.Bind(left_exits[state]);
+                as.Emit({0x4C, 0x39, 0xC6});     // cmp rsi, r8
+                as.JumpIf(Assembler::BELOW, lazy(grow_exits, state));
+                as.Emit({0x49, 0x89, 0xF3});     // mov r11, rsi
+                as.Jump(blocks[state]);
+            }
+            if (right_exits[state] != NONE) {
+                as.Bind(right_exits[state]);
+                as.Emit({0x4C, 0x39, 0xCE});     // cmp rsi, r9
+                as.JumpIf(Assembler::ABOVE_OR_EQUAL, lazy(grow_exits, state));
+                as.Emit({0x48, 0x89, 0xF2});     // mov rdx, rsi
+                as.Jump(blocks[state]);
+            }
+        }
+        for (size_t state = 0; state < n; ++state) {
+            if (grow_exits[state] != NONE) {
+                as.Bind(grow_exits[state]);
+                exit_with(state, jit_detail::EXIT_GROW);
+            }
+            if (budget_exits[state] != NONE) {
+                as.Bind(budget_exits[state]);
+                as.Emit({0x45, 0x31, 0xD2});     // xor r10d, r10d
+                exit_with(state, jit_detail::EXIT_BUDGET);
+            }
+        }
+
+        // Эпилог: регистры обратно в Context
+        as.Bind(epilogue);
+        as.Emit({0x48, 0x89, 0x37});             // mov [rdi], rsi
+        as.Emit({0x4C, 0x89, 0x5F, 0x18});       // mov [rdi + 24], r11
+        as.Emit({0x48, 0x89, 0x57, 0x20});       // mov [rdi + 32], rdx
+        as.Emit({0x4C, 0x89, 0x57, 0x28});       // mov [rdi + 40], r10
+        as.Emit({0x48, 0x89, 0x4F, 0x30});       // mov [rdi + 48], rcx
+        as.Emit({0x48, 0x89, 0x47, 0x38});       // mov [rdi + 56], rax
+        as.Emit({0xC3});                         // ret
+
+        // Таблица адресов блоков для входа по номеру состояния
+        as.Align(8);
+        as.Bind(table);
+        for (size_t state = 0; state < n; ++state) {
+            address_slots.push_back(as.AddressSlot(blocks[state]));
+        }
+        return as.Finish();
+    }
+
+public:
+    explicit JitProgram(const MachineDefinition<State, Symbol>& definition) : definition_(definition) {
+        // Как и в TuringMachine, из правил с одинаковыми (состояние, символ) действует последнее
+        TransitionManager<State, Symbol> transitions;
+        for (const auto& rule : definition.rules) {
+            transitions.AddRule(rule);
+        }
+        auto rules = transitions.GetAllRules();
+
+        StateIndex(definition.initial_state);
+        for (const auto& rule : rules) {
+            StateIndex(rule.from_state);
+            StateIndex(rule.to_state);
+        }
+        for (const auto& state : definition.final_states) {
+            StateIndex(state);
+        }
+
+        bool fits = true;
+        auto add_symbol = [&](const Symbol& symbol) {
+            if (symbol_code_.count(symbol) != 0) return;
+            if (alphabet_.size() == FOREIGN_CODE) {
+                fits = false;
+                return;
+            }
+            symbol_code_.emplace(symbol, static_cast<uint8_t>(alphabet_.size()));
+            alphabet_.push_back(symbol);
+        };
+        add_symbol(definition.blank_symbol);
+        for (const auto& rule : rules) {
+            add_symbol(rule.read_symbol);
+            add_symbol(rule.write_symbol);
+        }
+
+#if JIT_ENGINE_USE_X86_64
+        if (!fits) {
+            return;
+        }
+
+        std::vector<bool> is_final(states_.size(), false);
+        for (const auto& state : definition.final_states) {
+            is_final[state_index_.at(state)] = true;
+        }
+
+        TraceSpan span("machine", "jit compile");
+        std::vector<size_t> address_slots;
+        auto code = Generate(rules, is_final, address_slots);
+        if (memory_.Load(std::move(code), address_slots)) {
+            entry_ = reinterpret_cast<Entry>(const_cast<void*>(memory_.GetData()));
+        }
+#endif
+    }
+
+    JitProgram(const JitProgram&) = delete;
+    JitProgram& operator=(const JitProgram&) = delete;
+
+    /**
+     * Есть ли машинный код (иначе исполняет интерпретатор)
+     */
+    bool IsCompiled() const {
+        return entry_ != nullptr;
+    }
+
+    /**
+     * Размер исполняемой области (байт, кратно странице)
+     */
+    size_t GetCodeSize() const {
+        return memory_.GetSize();
+    }
+
+    const MachineDefinition<State, Symbol>& GetDefinition() const {
+        return definition_;
+    }
+};
+
+/**
+ * JIT-движок: компилирует машину в машинный код x86-64 и исполняет его
+ * Для пакетов с одной машиной программу стоит скомпилировать один раз
+ * (JitProgram) и исполнять её на разных входах. Без машинного кода
+ * исполнение передаётся InterpreterEngine
+ */
+template <typename State, typename Symbol>
+class JitEngine : public IExecutionEngine<State, Symbol> {
+private:
+    /**
+     * Буфер ленты из байтовых номеров символов; позиция p лежит в cells[origin + p]
+     */
+    struct Tape {
+        std::vector<uint8_t> cells;
+        size_t origin = 0;
+
+        uint8_t* At(long long position) {
+            return cells.data() + static_cast<long long>(origin) + position;
+        }
+
+        long long PositionOf(const uint8_t* cell) const {
+            return static_cast<long long>(reinterpret_cast<uintptr_t>(cell) -
+                                          reinterpret_cast<uintptr_t>(cells.data())) -
+                   static_cast<long long>(origin);
+        }
+    };
+
+public:
+    /**
+     * Доступна ли компиляция на этой платформе
+     */
+    static constexpr bool IsAvailable() {
+        return JIT_ENGINE_USE_X86_64 != 0;
+    }
+
+    std::string GetName() const override {
+        return "jit";
+    }
+
+    EngineOutcome<State, Symbol> Execute(const MachineDefinition<State, Symbol>& machine,
+                                         const std::vector<Symbol>& input,
+                                         size_t max_steps,
+                                         const std::atomic<bool>& cancel) const override {
+        JitProgram<State, Symbol> program(machine);
+        return Execute(program, input, max_steps, cancel);
+    }
+
+    /**
+     * Исполнить заранее скомпилированную программу
+     */
+    EngineOutcome<State, Symbol> Execute(const JitProgram<State, Symbol>& program,
+                                         const std::vector<Symbol>& input,
+                                         size_t max_steps,
+                                         const std::atomic<bool>& cancel) const {
+        if (!program.IsCompiled()) {
+            return InterpreterEngine<State, Symbol>().Execute(program.definition_, input, max_steps, cancel);
+        }
+
+        const uint8_t blank = program.symbol_code_.at(program.definition_.blank_symbol);
+        Tape tape;
+        tape.origin = std::max<size_t>(1024, input.size());
+        tape.cells.assign(input.size() + 2 * tape.origin, blank);
+        for (size_t i = 0; i < input.size(); ++i) {
+            auto it = program.symbol_code_.find(input[i]);
+            tape.cells[tape.origin + i] = (it != program.symbol_code_.end()) ? it->second : program.FOREIGN_CODE;
+        }
+
+        jit_detail::Context context;
+        context.head = context.min_head = context.max_head = tape.At(0);
+        context.state = program.state_index_.at(program.definition_.initial_state);
+
+        EngineOutcome<State, Symbol> outcome;
+        ProfiledRegion profiled(ProfileStateId(program.definition_.initial_state), 0);
+        bool profiling = SamplingProfiler::IsEnabled();
+        size_t steps = 0;
+        while (true) {
+            if (steps < max_steps && steps % this->CANCEL_CHECK_INTERVAL == 0 &&
+                cancel.load(std::memory_order_relaxed)) {
+                outcome.cancelled = true;
+                return outcome;
+            }
+
+            // Срез до следующей проверки отмены
+            size_t budget = std::min(max_steps - steps, this->CANCEL_CHECK_INTERVAL - steps % this->CANCEL_CHECK_INTERVAL);
+            context.low = tape.cells.data();
+            context.high = tape.cells.data() + tape.cells.size();
+            context.budget = budget;
+            program.entry_(&context);
+            steps += budget - context.budget;
+            if (profiling) {
+                SamplingProfiler::Publish(ProfileStateId(program.states_[context.state]), tape.PositionOf(context.head));
+            }
+
+            if (context.exit == jit_detail::EXIT_ACCEPT) {
+                outcome.result = ExecutionResult::ACCEPTED;
+                break;
+            }
+            if (context.exit == jit_detail::EXIT_REJECT) {
+                outcome.result = ExecutionResult::REJECTED;
+                break;
+            }
+            if (context.exit == jit_detail::EXIT_GROW) {
+                // Буфер удваивается в сторону выхода головки
+                long long head = tape.PositionOf(context.head);
+                long long min_head = std::min(tape.PositionOf(context.min_head), head);
+                long long max_head = std::max(tape.PositionOf(context.max_head), head);
+                size_t grow = tape.cells.size();
+                if (head < 0 && static_cast<size_t>(-head) > tape.origin) {
+                    tape.cells.insert(tape.cells.begin(), grow, blank);
+                    tape.origin += grow;
+                } else {
+                    tape.cells.resize(tape.cells.size() + grow, blank);
+                }
+                context.head = tape.At(head);
+                context.min_head = tape.At(min_head);
+                context.max_head = tape.At(max_head);
+                continue;
+            }
+            if (steps >= max_steps) {
+                outcome.result = ExecutionResult::TIMEOUT;
+                break;
+            }
+        }
+
+        long long head = tape.PositionOf(context.head);
+        outcome.steps = steps;
+        outcome.final_state = program.states_[context.state];
+        outcome.head_position = static_cast<int>(head);
+        auto [start, end] = this->OutputRange(input.size(), static_cast<int>(tape.PositionOf(context.min_head)),
+                                              static_cast<int>(tape.PositionOf(context.max_head)));
+        outcome.tape_start = start;
+        outcome.tape.reserve(static_cast<size_t>(end - start + 1));
+        for (int position = start; position <= end; ++position) {
+            uint8_t code = *tape.At(position);
+            outcome.tape.push_back(code == program.FOREIGN_CODE ? input[static_cast<size_t>(position)]
+                                                                : program.alphabet_[code]);
+        }
+        return outcome;
+    }
+};
@@ -2,11 +2,76 @@
 
 #include "../SmartPtrs.h"
 #include "../ArraySeq.h"
+#include "Mem.h"
 
 #include <optional>
 #include <functional>
 #include <limits>
 #include <utility>
+#include <type_traits>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <string>
+
+/**
+ * Признак генератора с константным хвостом: начиная с ConstantTailStart()
+ * он выдаёт только ConstantTailValue(). Для таких генераторов LazySeq
+ * не материализует хвост при чтении
+ */
+template <typename Generator, typename = void>
+struct HasConstantTail : std::false_type {};
+
+template <typename Generator>
+struct HasConstantTail<Generator, std::void_t<
+    decltype(std::declval<const Generator&>().ConstantTailStart()),
+    decltype(std::declval<const Generator&>().ConstantTailValue())>> : std::true_type {};
+
+/**
+ * Признак генератора, выдающего элементы пакетами: NextBatch(max_count)
+ * возвращает пару (указатель, длина), длина 0 означает конец
+ */
+template <typename Generator, typename = void>
+struct HasBatchGeneration : std::false_type {};
+
+template <typename Generator>
+struct HasBatchGeneration<Generator, std::void_t<
+    decltype(std::declval<Generator&>().NextBatch(size_t{}))>> : std::true_type {};
+
+/**
+ * Признак Mem с непрерывным хранением: Data(i) указывает на элемент i,
+ * за которым подряд лежат остальные материализованные элементы
+ */
+template <typename Mem, typename = void>
+struct HasContiguousStorage : std::false_type {};
+
+template <typename Mem>
+struct HasContiguousStorage<Mem, std::void_t<
+    decltype(std::declval<const Mem&>().Data(size_t{}))>> : std::true_type {};
+
+/**
+ * Признак Mem, сообщающего свой объём в байтах
+ */
+template <typename Mem, typename = void>
+struct HasMemoryBytes : std::false_type {};
+
+template <typename Mem>
+struct HasMemoryBytes<Mem, std::void_t<
+    decltype(std::declval<const Mem&>().GetMemoryBytes())>> : std::true_type {};
+
+/**
+ * Непрерывный участок элементов
+ */
+template <typename T>
+struct SeqSpan {
+    T* data = nullptr;
+    size_t size = 0;
+
+    T* begin() const { return data; }
+    T* end() const { return data + size; }
+    T& operator[](size_t i) const { return data[i]; }
+    bool empty() const { return size == 0; }
+};
 
 template <typename T, typename Generator, typename Mem>
 class LazySeq {
@@ -15,21 +80,56 @@ private:
     mutable Generator gen_; 
     size_t max_len_;
 
+    // Сколько элементов генератор ещё должен пропустить: Mem мог прийти
+    // с уже материализованным префиксом (например, загруженным из файла)
+    mutable size_t generator_lag_;
+
+    /**
+     * Догнать генератором материализованный префикс
+     */
+    void CatchUpGenerator() const {
+        while (generator_lag_ > 0) {
+            if constexpr (HasBatchGeneration<Generator>::value) {
+                size_t skipped = gen_.NextBatch(generator_lag_).second;
+                if (skipped == 0) {
+                    generator_lag_ = 0;
+                    break;
+                }
+                generator_lag_ -= skipped;
+            } else {
+                try {
+                    gen_.GetNext();
+                } catch (...) {
+                    generator_lag_ = 0;
+                    break;
+                }
+                generator_lag_--;
+            }
+        }
+    }
+
 public:
     static constexpr size_t INF = std::numeric_limits<size_t>::max();
 
 public:
+    /**
+     * @param mem Память; если в ней уже есть префикс, генератор считается стоящим
+     *            в начале последовательности и пропустит префикс при первой
+     *            материализации за его пределами
+     */
     explicit LazySeq(Generator gen, Mem mem, size_t max_len = INF) 
-        : mem_(std::move(mem)), gen_(std::move(gen)), max_len_(max_len) {}
+        : mem_(std::move(mem)), gen_(std::move(gen)), max_len_(max_len),
+          generator_lag_(mem_.MaterializedCount()) {}
 
 
     LazySeq(const LazySeq& other) 
-        : mem_(other.mem_), gen_(other.gen_), max_len_(other.max_len_) {}
+        : mem_(other.mem_), gen_(other.gen_), max_len_(other.max_len_),
+          generator_lag_(other.generator_lag_) {}
 
 
     LazySeq(LazySeq&& other) : mem_(std::move(other.mem_)), 
           gen_(std::move(other.gen_)), 
-          max_len_(other.max_len_) {}
+          max_len_(other.max_len_), generator_lag_(other.generator_lag_) {}
 
 
     LazySeq& operator=(const LazySeq& other) {
@@ -37,6 +137,7 @@ public:
             mem_ = other.mem_;
             gen_ = other.gen_;
             max_len_ = other.max_len_;
+            generator_lag_ = other.generator_lag_;
         }
         return *this;
     }
@@ -46,6 +147,7 @@ public:
             mem_ = std::move(other.mem_);
             gen_ = std::move(other.gen_);
             max_len_ = other.max_len_;
+            generator_lag_ = other.generator_lag_;
         }
         return *this;
     }
@@ -55,32 +157,29 @@ public:
         if (hit) {
             return hit;
         }
-        while (mem_.MaterializedCount() <= i && mem_.MaterializedCount() < max_len_) {
-            try {
-                T next = gen_.GetNext();
-                mem_.Append(std::move(next));
-            } catch (...) {
-                break;
-            }
+        if (i < max_len_) {
+            MaterializeUpTo(i + 1);
         }
-
         return mem_.Get(i);
     }
 
+    /**
+     * Чтение без намерения записи: элементы константного хвоста
+     * не добавляются в Mem, возвращается ссылка на значение хвоста
+     */
     std::optional<std::reference_wrapper<const T>> Get(size_t i) const {
         auto hit = mem_.Get(i);
         if (hit) {
             return hit;
         }
-        while (mem_.MaterializedCount() <= i && mem_.MaterializedCount() < max_len_) {
-            try {
-                T next = gen_.GetNext();
-                mem_.Append(std::move(next));
-            } catch (...) {
-                break;
+        if constexpr (HasConstantTail<Generator>::value) {
+            if (i >= gen_.ConstantTailStart() && i < max_len_) {
+                return std::cref(gen_.ConstantTailValue());
             }
         }
-
+        if (i < max_len_) {
+            MaterializeUpTo(i + 1);
+        }
         return mem_.Get(i);
     }
 
@@ -88,7 +187,239 @@ public:
         return mem_.MaterializedCount(); 
     }
     
+    /**
+     * Объём кеша материализованных элементов (байт)
+     */
+    size_t GetMemoryBytes() const noexcept {
+        if constexpr (HasMemoryBytes<Mem>::value) {
+            return mem_.GetMemoryBytes();
+        } else {
+            return mem_.MaterializedCount() * sizeof(T);
+        }
+    }
+    
     size_t MaxLen() const noexcept { 
         return max_len_; 
     }
+    
+    /**
+     * Индекс начала неявного хвоста (INF, если генератор его не поддерживает)
+     */
+    size_t ImplicitTailStart() const {
+        if constexpr (HasConstantTail<Generator>::value) {
+            return gen_.ConstantTailStart();
+        } else {
+            return INF;
+        }
+    }
+
+    /**
+     * Материализовать элементы с индексами меньше end одним пакетом
+     * @return Сколько элементов материализовано (меньше end, если генератор иссяк)
+     */
+    size_t MaterializeUpTo(size_t end) const {
+        end = std::min(end, max_len_);
+        if (mem_.MaterializedCount() < end) {
+            CatchUpGenerator();
+        }
+        while (mem_.MaterializedCount() < end) {
+            if constexpr (HasBatchGeneration<Generator>::value) {
+                auto [data, count] = gen_.NextBatch(end - mem_.MaterializedCount());
+                if (count == 0) {
+                    break;
+                }
+                for (size_t k = 0; k < count; ++k) {
+                    mem_.Append(data[k]);
+                }
+            } else {
+                try {
+                    mem_.Append(gen_.GetNext());
+                } catch (...) {
+                    break;
+                }
+            }
+        }
+        return mem_.MaterializedCount();
+    }
+
+    /**
+     * Диапазон непрерывных участков [first, last)
+     * Участки материализуются вперёд блоками по block элементов; константный
+     * хвост не материализуется и отдаётся из буфера диапазона. Если Mem не
+     * хранит элементы подряд, участки копируются в тот же буфер
+     */
+    class SpanRange {
+    private:
+        const LazySeq* seq_;
+        size_t position_;
+        size_t last_;
+        size_t block_;
+        std::vector<T> buffer_;
+        bool buffer_holds_tail_ = false;
+
+    public:
+        SpanRange(const LazySeq* seq, size_t first, size_t last, size_t block)
+            : seq_(seq), position_(first), last_(std::min(last, seq->max_len_)), block_(std::max<size_t>(1, block)) {}
+
+        /**
+         * Следующий участок; пустой участок означает конец диапазона.
+         * Участок действителен до следующего вызова Next()
+         */
+        SeqSpan<const T> Next() {
+            if (position_ >= last_) {
+                return {};
+            }
+
+            size_t tail_start = seq_->ImplicitTailStart();
+            if constexpr (HasConstantTail<Generator>::value) {
+                if (position_ >= tail_start && position_ >= seq_->MaterializedCount()) {
+                    size_t count = std::min(block_, last_ - position_);
+                    if (!buffer_holds_tail_ || buffer_.size() != count) {
+                        buffer_.assign(count, seq_->gen_.ConstantTailValue());
+                        buffer_holds_tail_ = true;
+                    }
+                    position_ += count;
+                    return {buffer_.data(), count};
+                }
+            }
+
+            // До хвоста материализуем блок, внутри уже материализованного - отдаём всё сразу
+            size_t materialized = seq_->MaterializedCount();
+            size_t wanted = std::min(last_, position_ + block_);
+            if (position_ < tail_start) {
+                wanted = std::max(std::min(wanted, tail_start), std::min(last_, materialized));
+            } else {
+                wanted = std::min(last_, materialized);
+            }
+            size_t available = std::min(wanted, seq_->MaterializeUpTo(wanted));
+            if (available <= position_) {
+                position_ = last_;   // Генератор иссяк
+                return {};
+            }
+
+            size_t count = available - position_;
+            SeqSpan<const T> span;
+            if constexpr (HasContiguousStorage<Mem>::value) {
+                span = {seq_->mem_.Data(position_), count};
+            } else {
+                buffer_.clear();
+                buffer_holds_tail_ = false;
+                for (size_t i = position_; i < available; ++i) {
+                    buffer_.push_back(seq_->mem_.Get(i)->get());
+                }
+                span = {buffer_.data(), count};
+            }
+            position_ = available;
+            return span;
+        }
+
+        /**
+         * Итератор по участкам (для range-for)
+         */
+        class Iterator {
+        private:
+            SpanRange* range_;
+            SeqSpan<const T> current_;
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = SeqSpan<const T>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const SeqSpan<const T>*;
+            using reference = const SeqSpan<const T>&;
+
+            explicit Iterator(SpanRange* range) : range_(range), current_(range ? range->Next() : SeqSpan<const T>{}) {
+                if (current_.empty()) range_ = nullptr;
+            }
+
+            reference operator*() const { return current_; }
+            pointer operator->() const { return &current_; }
+
+            Iterator& operator++() {
+                current_ = range_->Next();
+                if (current_.empty()) range_ = nullptr;
+                return *this;
+            }
+
+            bool operator==(const Iterator& other) const { return range_ == other.range_; }
+            bool operator!=(const Iterator& other) const { return range_ != other.range_; }
+        };
+
+        Iterator begin() { return Iterator(this); }
+        Iterator end() { return Iterator(nullptr); }
+    };
+
+    /**
+     * Поэлементный диапазон [first, last) поверх участков
+     * Итераторы годятся для стандартных алгоритмов (std::accumulate, std::count, ...)
+     */
+    class ElementRange {
+    private:
+        SpanRange spans_;
+
+    public:
+        ElementRange(const LazySeq* seq, size_t first, size_t last, size_t block)
+            : spans_(seq, first, last, block) {}
+
+        class Iterator {
+        private:
+            typename SpanRange::Iterator span_;
+            const T* current_ = nullptr;
+            const T* span_end_ = nullptr;
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            explicit Iterator(typename SpanRange::Iterator span) : span_(span) {
+                if (span_ != typename SpanRange::Iterator(nullptr)) {
+                    current_ = span_->begin();
+                    span_end_ = span_->end();
+                }
+            }
+
+            reference operator*() const { return *current_; }
+            pointer operator->() const { return current_; }
+
+            Iterator& operator++() {
+                if (++current_ == span_end_) {
+                    ++span_;
+                    if (span_ != typename SpanRange::Iterator(nullptr)) {
+                        current_ = span_->begin();
+                        span_end_ = span_->end();
+                    } else {
+                        current_ = span_end_ = nullptr;
+                    }
+                }
+                return *this;
+            }
+
+            bool operator==(const Iterator& other) const { return current_ == other.current_; }
+            bool operator!=(const Iterator& other) const { return current_ != other.current_; }
+        };
+
+        Iterator begin() { return Iterator(spans_.begin()); }
+        Iterator end() { return Iterator(spans_.end()); }
+    };
+
+    /**
+     * Сохранить материализованный префикс (см. SaveMem); загруженный через
+     * MappedSeqMem::Load, он избавляет следующий запуск от повторной генерации
+     */
+    void SaveMaterialized(const std::string& path) const {
+        SaveMem<T>(mem_, path);
+    }
+
+    static constexpr size_t DEFAULT_SPAN_BLOCK = 4096;
+
+    SpanRange Spans(size_t first, size_t last, size_t block = DEFAULT_SPAN_BLOCK) const {
+        return SpanRange(this, first, last, block);
+    }
+
+    ElementRange Elements(size_t first, size_t last, size_t block = DEFAULT_SPAN_BLOCK) const {
+        return ElementRange(this, first, last, block);
+    }
 };
@@ -6,9 +6,14 @@
 #include "StateManager.h"
 #include "TuringStrip.h"
 #include "HeadManager.h"
+#include "StateGraphAnalysis.h"
+#include "Tracer.h"
+#include "Profiler.h"
 
 #include <stdexcept>
 #include <sstream>
+#include <memory>
+#include <algorithm>
 
 /**
  * Результат выполнения машины Тьюринга
@@ -17,24 +22,100 @@ enum class ExecutionResult {
     ACCEPTED,     // Принято (достигнуто конечное состояние)
     REJECTED,     // Отклонено (нет правила для перехода)
     TIMEOUT,      // Превышен лимит шагов
-    ERROR         // Ошибка выполнения
+    ERROR,        // Ошибка выполнения
+    NON_HALTING   // Машина попала в ловушку и никогда не остановится (см. StateGraphAnalysis)
+};
+
+/**
+ * Снимок конфигурации машины для продолжения выполнения
+ * Лента хранится компактно: только отрезок с входом и записанными ячейками
+ */
+template <typename State, typename Symbol>
+struct MachineSnapshot {
+    State state;
+    int head_position = 0;
+    size_t step_count = 0;
+    int tape_start = 0;
+    std::vector<Symbol> tape;
+    
+    /**
+     * Приблизительный объём в памяти (байт)
+     */
+    size_t GetMemoryFootprint() const {
+        return sizeof(*this) + tape.capacity() * sizeof(Symbol);
+    }
 };
 
 /**
  * Машина Тьюринга
  * Основной класс, инкапсулирующий все компоненты машины Тьюринга
  * Использует композицию для управления состояниями, лентой, правилами переходов и статистикой
+ * @tparam Storage Хранилище ленты (см. TapeStorage.h)
  */
-template <typename State, typename Symbol>
+template <typename State, typename Symbol, typename Storage = LazyMapTapeStorage<Symbol>>
 class TuringMachine {
 private:
     // Используем твои самописные умные указатели
     UniquePtr<StateManager<State>> state_manager_;
-    UniquePtr<TuringStrip<Symbol>> strip_;  // Переименовано с tape_ на strip_
+    UniquePtr<TuringStrip<Symbol, Storage>> strip_;  // Переименовано с tape_ на strip_
     UniquePtr<TransitionManager<State, Symbol>> transition_manager_;
     UniquePtr<HeadManager> head_manager_;
     UniquePtr<StatisticsManager> statistics_manager_;
     
+    // Анализ графа состояний строится при первом запуске и сбрасывается при изменении машины
+    bool trap_detection_ = false;
+    std::unique_ptr<StateGraphAnalysis<State, Symbol>> analysis_;
+    
+    /**
+     * Основной цикл выполнения (общий для Run и Resume)
+     */
+    ExecutionResult RunLoop() {
+        ProfiledRegion profiled(ProfileStateId(state_manager_->GetCurrentState()), head_manager_->GetPosition());
+        try {
+            const StateGraphAnalysis<State, Symbol>* traps = trap_detection_ ? &GetStateGraphAnalysis() : nullptr;
+            if (traps && !traps->HasTraps()) {
+                traps = nullptr;
+            }
+            bool check_trap = traps != nullptr;
+            while (true) {
+                // Проверяем конечное состояние
+                if (state_manager_->IsInFinalState()) {
+                    statistics_manager_->EndExecution();
+                    return ExecutionResult::ACCEPTED;
+                }
+                
+                // Проверяем, не попала ли машина в ловушку
+                if (check_trap && traps->IsTrap(state_manager_->GetCurrentState())) {
+                    statistics_manager_->EndExecution();
+                    return ExecutionResult::NON_HALTING;
+                }
+                
+                // Проверяем превышение лимита шагов
+                if (statistics_manager_->IsStepLimitExceeded()) {
+                    statistics_manager_->EndExecution();
+                    return ExecutionResult::TIMEOUT;
+                }
+                
+                // Выполняем шаг; ловушку достаточно проверять после смены состояния
+                bool stepped;
+                if (traps) {
+                    State previous = state_manager_->GetCurrentState();
+                    stepped = Step();
+                    check_trap = !(state_manager_->GetCurrentState() == previous);
+                } else {
+                    stepped = Step();
+                }
+                if (!stepped) {
+                    statistics_manager_->EndExecution();
+                    return ExecutionResult::REJECTED;
+                }
+            }
+        } catch (const std::exception&) {
+            statistics_manager_->EndExecution();
+            return ExecutionResult::ERROR;
+        }
+    }
+    
 public:
     /**
      * Конструктор машины Тьюринга
@@ -48,7 +129,7 @@ public:
                           const std::vector<Symbol>& initial_data = {},
                           int initial_head_position = 0)
         : state_manager_(UniquePtr<StateManager<State>>::MakeUnique(initial_state)),
-          strip_(UniquePtr<TuringStrip<Symbol>>::MakeUnique(blank_symbol, initial_data)),
+          strip_(UniquePtr<TuringStrip<Symbol, Storage>>::MakeUnique(blank_symbol, initial_data)),
           transition_manager_(UniquePtr<TransitionManager<State, Symbol>>::MakeUnique()),
           head_manager_(UniquePtr<HeadManager>::MakeUnique(initial_head_position)),
           statistics_manager_(UniquePtr<StatisticsManager>::MakeUnique()) {}
@@ -60,6 +141,19 @@ public:
                       const State& to_state, const Symbol& write_symbol,
                       Direction direction) {
         transition_manager_->AddRule(from_state, read_symbol, to_state, write_symbol, direction);
+        analysis_.reset();
+    }
+    
+    /**
+     * Добавить вариант перехода недетерминированной машины
+     * Run/Step исполняют только первый вариант для (состояние, символ);
+     * все варианты перебирает NondeterministicExplorer
+     */
+    void AddNondeterministicTransition(const State& from_state, const Symbol& read_symbol,
+                                       const State& to_state, const Symbol& write_symbol,
+                                       Direction direction) {
+        transition_manager_->AddNondeterministicRule(from_state, read_symbol, to_state, write_symbol, direction);
+        analysis_.reset();
     }
     
     /**
@@ -67,6 +161,43 @@ public:
      */
     void AddFinalState(const State& state) {
         state_manager_->AddFinalState(state);
+        analysis_.reset();
+    }
+    
+    /**
+     * Останавливать Run/Resume с NON_HALTING на том шаге, которым машина
+     * вошла в состояние, из которого остановка невозможна (проверка только
+     * при смене состояния; анализ строится один раз за O(правил + входа))
+     */
+    void EnableTrapDetection(bool enabled = true) {
+        trap_detection_ = enabled;
+    }
+    
+    bool IsTrapDetectionEnabled() const {
+        return trap_detection_;
+    }
+    
+    /**
+     * Анализ графа состояний для текущих правил, конечных состояний и ленты
+     */
+    const StateGraphAnalysis<State, Symbol>& GetStateGraphAnalysis() {
+        if (!analysis_) {
+            std::vector<Symbol> symbols{strip_->GetBlankSymbol()};
+            auto [first, last] = strip_->GetUsedRange();
+            if (first <= last) {
+                auto segment = strip_->GetSegment(first, static_cast<size_t>(last - first + 1));
+                symbols.insert(symbols.end(), segment.begin(), segment.end());
+            }
+            analysis_ = std::make_unique<StateGraphAnalysis<State, Symbol>>(*transition_manager_, *state_manager_, symbols);
+        }
+        return *analysis_;
+    }
+    
+    /**
+     * Сбросить анализ (после изменения правил или ленты в обход машины)
+     */
+    void InvalidateStateGraphAnalysis() {
+        analysis_.reset();
     }
     
     /**
@@ -94,9 +225,14 @@ public:
         state_manager_->SetCurrentState(rule->to_state);
         strip_->SetSymbolAt(head_manager_->GetPosition(), rule->write_symbol);
         head_manager_->Move(rule->direction);
+        if (SamplingProfiler::IsEnabled()) {
+            SamplingProfiler::Publish(ProfileStateId(rule->to_state), head_manager_->GetPosition());
+        }
         
         // Обновляем статистику
-        statistics_manager_->IncrementStepCount();
+        if (statistics_manager_->IncrementStepCount()) {
+            statistics_manager_->RecordThroughputSample(strip_->GetMemoryFootprint().GetTotal());
+        }
         
         return true;
     }
@@ -111,42 +247,80 @@ public:
             statistics_manager_->SetMaxSteps(max_steps);
         }
         
+        TraceSpan span("machine", "run");
         statistics_manager_->StartExecution();
+        ExecutionResult result = RunLoop();
+        statistics_manager_->RecordMemoryUsage(strip_->GetMemoryFootprint().GetTotal());
+        span.SetArg("steps", static_cast<long long>(statistics_manager_->GetStepCount()));
+        return result;
+    }
+    
+    /**
+     * Продолжить выполнение после TIMEOUT без сброса счётчика шагов
+     * @param max_steps Новый общий лимит шагов (с учётом уже выполненных)
+     * @return Результат выполнения
+     */
+    ExecutionResult Resume(size_t max_steps) {
+        statistics_manager_->SetMaxSteps(max_steps);
+        TraceSpan span("machine", "resume");
+        statistics_manager_->ResumeExecution();
+        ExecutionResult result = RunLoop();
+        statistics_manager_->RecordMemoryUsage(strip_->GetMemoryFootprint().GetTotal());
+        span.SetArg("steps", static_cast<long long>(statistics_manager_->GetStepCount()));
+        return result;
+    }
+    
+    /**
+     * Снять снимок текущей конфигурации
+     */
+    MachineSnapshot<State, Symbol> CreateSnapshot() const {
+        MachineSnapshot<State, Symbol> snapshot;
+        snapshot.state = state_manager_->GetCurrentState();
+        snapshot.head_position = head_manager_->GetPosition();
+        snapshot.step_count = statistics_manager_->GetStepCount();
         
-        try {
-            while (true) {
-                // Проверяем конечное состояние
-                if (state_manager_->IsInFinalState()) {
-                    statistics_manager_->EndExecution();
-                    return ExecutionResult::ACCEPTED;
-                }
-                
-                // Проверяем превышение лимита шагов
-                if (statistics_manager_->IsStepLimitExceeded()) {
-                    statistics_manager_->EndExecution();
-                    return ExecutionResult::TIMEOUT;
-                }
-                
-                // Выполняем шаг
-                if (!Step()) {
-                    statistics_manager_->EndExecution();
-                    return ExecutionResult::REJECTED;
-                }
+        auto [first, last] = strip_->GetUsedRange();
+        if (first <= last) {
+            snapshot.tape_start = first;
+            snapshot.tape = strip_->GetSegment(first, static_cast<size_t>(last - first + 1));
+        }
+        return snapshot;
+    }
+    
+    /**
+     * Восстановить конфигурацию из снимка (правила и конечные состояния не меняются)
+     */
+    void RestoreSnapshot(const MachineSnapshot<State, Symbol>& snapshot) {
+        // Неотрицательная часть становится входом ленты, отрицательная - записями
+        size_t negative = snapshot.tape_start < 0
+            ? std::min(snapshot.tape.size(), static_cast<size_t>(-snapshot.tape_start)) : 0;
+        std::vector<Symbol> data(static_cast<size_t>(std::max(0, snapshot.tape_start)), strip_->GetBlankSymbol());
+        data.insert(data.end(), snapshot.tape.begin() + static_cast<std::ptrdiff_t>(negative), snapshot.tape.end());
+        strip_->Reset(data);
+        for (size_t i = 0; i < negative; ++i) {
+            if (!(snapshot.tape[i] == strip_->GetBlankSymbol())) {
+                strip_->SetSymbolAt(snapshot.tape_start + static_cast<int>(i), snapshot.tape[i]);
             }
-        } catch (const std::exception&) {
-            statistics_manager_->EndExecution();
-            return ExecutionResult::ERROR;
         }
+        
+        state_manager_->SetCurrentState(snapshot.state);
+        head_manager_->Reset();
+        head_manager_->SetPosition(snapshot.head_position);
+        statistics_manager_->Reset();
+        statistics_manager_->SetStepCount(snapshot.step_count);
+        analysis_.reset();
     }
     
     /**
      * Сбросить машину в начальное состояние
      */
     void Reset(const std::vector<Symbol>& new_data = {}) {
+        TraceSpan span("machine", "reset");
         state_manager_->Reset();
         head_manager_->Reset();
         strip_->Reset(new_data);
         statistics_manager_->Reset();
+        analysis_.reset();
     }
     
     // ===================
@@ -208,6 +382,23 @@ public:
     void PrintStatistics(std::ostream& out = std::cout) const {
         statistics_manager_->PrintStatistics(out);
         head_manager_->PrintMoveStatistics(out);
+        GetMemoryFootprint().Print(out);
+    }
+    
+    /**
+     * Разбивка занятой памяти по назначению
+     * Контейнеры ведут учёт своих выделений, поэтому вызов дешёвый (O(1)).
+     * Байты точны для тривиально копируемых State и Symbol; собственная
+     * память составных состояний (например, строк) не учитывается
+     */
+    MemoryFootprint GetMemoryFootprint() const {
+        MemoryFootprint footprint = strip_->GetMemoryFootprint();
+        footprint.rules = sizeof(TransitionManager<State, Symbol>) + transition_manager_->GetMemoryBytes();
+        footprint.metadata += sizeof(*this)
+                            + sizeof(StateManager<State>) + state_manager_->GetMemoryBytes()
+                            + sizeof(HeadManager)
+                            + statistics_manager_->GetMemoryBytes();
+        return footprint;
     }
     
     /**
@@ -247,6 +438,7 @@ public:
      */
     void SetSymbolAt(int position, const Symbol& symbol) {
         strip_->SetSymbolAt(position, symbol);
+        analysis_.reset();   // Алфавит анализа собран по ленте
     }
     
     /**
@@ -311,8 +503,10 @@ public:
     
     /**
      * Получить доступ к менеджеру состояний
+     * (изменяемый доступ сбрасывает анализ графа состояний)
      */
     StateManager<State>& GetStateManager() { 
+        InvalidateStateGraphAnalysis();
         return *state_manager_; 
     }
     
@@ -322,19 +516,23 @@ public:
     
     /**
      * Получить доступ к ленте
+     * (изменяемый доступ сбрасывает анализ графа состояний)
      */
-    TuringStrip<Symbol>& GetStrip() { 
+    TuringStrip<Symbol, Storage>& GetStrip() { 
+        InvalidateStateGraphAnalysis();
         return *strip_; 
     }
     
-    const TuringStrip<Symbol>& GetStrip() const { 
+    const TuringStrip<Symbol, Storage>& GetStrip() const { 
         return *strip_; 
     }
     
     /**
      * Получить доступ к менеджеру переходов
+     * (изменяемый доступ сбрасывает анализ графа состояний)
      */
     TransitionManager<State, Symbol>& GetTransitionManager() { 
+        InvalidateStateGraphAnalysis();
         return *transition_manager_; 
     }
     
@@ -368,13 +566,13 @@ public:
 /**
  * Вспомогательная функция для создания машины Тьюринга
  */
-template <typename State, typename Symbol>
-UniquePtr<TuringMachine<State, Symbol>> MakeTuringMachine(
+template <typename State, typename Symbol, typename Storage = LazyMapTapeStorage<Symbol>>
+UniquePtr<TuringMachine<State, Symbol, Storage>> MakeTuringMachine(
     const State& initial_state,
     const Symbol& blank_symbol,
     const std::vector<Symbol>& initial_data = {},
     int initial_head_position = 0) {
     
-    return UniquePtr<TuringMachine<State, Symbol>>::MakeUnique(
+    return UniquePtr<TuringMachine<State, Symbol, Storage>>::MakeUnique(
         initial_state, blank_symbol, initial_data, initial_head_position);
 }
\ No newline at end of file
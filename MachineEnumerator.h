@@ -0,0 +1,264 @@
+#pragma once
+
+#include "TransitionManager.h"
+
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+/**
+ * Одна ячейка таблицы переходов перечисляемой машины
+ * Неопределённый переход означает остановку машины
+ */
+struct MachineTableEntry {
+    bool defined = false;
+    int to_state = 0;
+    int write_symbol = 0;
+    Direction direction = Direction::RIGHT;
+
+    bool operator==(const MachineTableEntry& other) const {
+        if (defined != other.defined) return false;
+        if (!defined) return true;
+        return to_state == other.to_state && write_symbol == other.write_symbol &&
+               direction == other.direction;
+    }
+};
+
+/**
+ * Перечислитель машин Тьюринга с n состояниями и k символами
+ * Состояние 0 - начальное, символ 0 - пустой. Направления только LEFT/RIGHT.
+ * Ответственность: полный перебор таблиц переходов и отсечение
+ * симметричных (изоморфных) машин
+ *
+ * Группа симметрий: перестановки состояний, сохраняющие начальное,
+ * перестановки символов, сохраняющие пустой, и зеркало LEFT <-> RIGHT.
+ * Представитель орбиты - лексикографически минимальная таблица
+ */
+class MachineEnumerator {
+public:
+    using Table = std::vector<MachineTableEntry>;
+
+private:
+    int states_count_;
+    int symbols_count_;
+
+    // Все перестановки состояний и символов, сохраняющие 0
+    std::vector<std::vector<int>> state_permutations_;
+    std::vector<std::vector<int>> symbol_permutations_;
+
+    static std::vector<std::vector<int>> BuildPermutations(int size) {
+        std::vector<std::vector<int>> result;
+        std::vector<int> perm(size);
+        std::iota(perm.begin(), perm.end(), 0);
+        do {
+            result.push_back(perm);
+        } while (size > 1 && std::next_permutation(perm.begin() + 1, perm.end()));
+        return result;
+    }
+
+    size_t Index(int state, int symbol) const {
+        return static_cast<size_t>(state * symbols_count_ + symbol);
+    }
+
+    /**
+     * Код ячейки для лексикографического сравнения (0 - неопределённый переход)
+     */
+    int EncodeEntry(const MachineTableEntry& entry) const {
+        if (!entry.defined) return 0;
+        int dir = (entry.direction == Direction::LEFT) ? 0 : 1;
+        return 1 + (entry.to_state * symbols_count_ + entry.write_symbol) * 2 + dir;
+    }
+
+    MachineTableEntry DecodeEntry(int code) const {
+        MachineTableEntry entry;
+        if (code == 0) return entry;
+        code -= 1;
+        entry.defined = true;
+        entry.direction = (code % 2 == 0) ? Direction::LEFT : Direction::RIGHT;
+        code /= 2;
+        entry.write_symbol = code % symbols_count_;
+        entry.to_state = code / symbols_count_;
+        return entry;
+    }
+
+    /**
+     * Применить элемент группы симметрий к таблице
+     */
+    Table Transform(const Table& table, const std::vector<int>& state_perm,
+                    const std::vector<int>& symbol_perm, bool mirror) const {
+        Table result(table.size());
+        for (int s = 0; s < states_count_; ++s) {
+            for (int a = 0; a < symbols_count_; ++a) {
+                const auto& entry = table[Index(s, a)];
+                auto& target = result[Index(state_perm[s], symbol_perm[a])];
+                target.defined = entry.defined;
+                if (!entry.defined) continue;
+                target.to_state = state_perm[entry.to_state];
+                target.write_symbol = symbol_perm[entry.write_symbol];
+                target.direction = entry.direction;
+                if (mirror) {
+                    target.direction = (entry.direction == Direction::LEFT) ? Direction::RIGHT : Direction::LEFT;
+                }
+            }
+        }
+        return result;
+    }
+
+    bool Less(const Table& lhs, const Table& rhs) const {
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            int l = EncodeEntry(lhs[i]);
+            int r = EncodeEntry(rhs[i]);
+            if (l != r) return l < r;
+        }
+        return false;
+    }
+
+public:
+    MachineEnumerator(int states_count, int symbols_count)
+        : states_count_(states_count), symbols_count_(symbols_count) {
+        if (states_count <= 0 || symbols_count <= 0) {
+            throw std::invalid_argument("Количество состояний и символов должно быть положительным");
+        }
+        state_permutations_ = BuildPermutations(states_count);
+        symbol_permutations_ = BuildPermutations(symbols_count);
+    }
+
+    int GetStatesCount() const { return states_count_; }
+    int GetSymbolsCount() const { return symbols_count_; }
+
+    /**
+     * Размер группы симметрий: (n-1)! * (k-1)! * 2
+     */
+    size_t GetSymmetryGroupSize() const {
+        return state_permutations_.size() * symbol_permutations_.size() * 2;
+    }
+
+    /**
+     * Количество всех таблиц: (2nk + 1)^(nk)
+     */
+    size_t GetTotalTablesCount() const {
+        size_t options = static_cast<size_t>(2 * states_count_ * symbols_count_ + 1);
+        size_t cells = static_cast<size_t>(states_count_ * symbols_count_);
+        size_t total = 1;
+        for (size_t i = 0; i < cells; ++i) total *= options;
+        return total;
+    }
+
+    /**
+     * Канонический представитель орбиты таблицы
+     */
+    Table Canonicalize(const Table& table) const {
+        Table best = table;
+        for (const auto& state_perm : state_permutations_) {
+            for (const auto& symbol_perm : symbol_permutations_) {
+                for (bool mirror : {false, true}) {
+                    Table candidate = Transform(table, state_perm, symbol_perm, mirror);
+                    if (Less(candidate, best)) {
+                        best = std::move(candidate);
+                    }
+                }
+            }
+        }
+        return best;
+    }
+
+    /**
+     * Является ли таблица представителем своей орбиты
+     * Прерывается на первом меньшем образе, поэтому дешевле Canonicalize
+     */
+    bool IsCanonical(const Table& table) const {
+        for (const auto& state_perm : state_permutations_) {
+            for (const auto& symbol_perm : symbol_permutations_) {
+                for (bool mirror : {false, true}) {
+                    if (Less(Transform(table, state_perm, symbol_perm, mirror), table)) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Перебрать все таблицы
+     * @param callback Вызывается для каждой выданной таблицы
+     * @param prune_symmetric Выдавать только канонических представителей
+     * @return Количество выданных таблиц
+     */
+    size_t Enumerate(const std::function<void(const Table&)>& callback, bool prune_symmetric = true) const {
+        const size_t cells = static_cast<size_t>(states_count_ * symbols_count_);
+        const int options = 2 * states_count_ * symbols_count_ + 1;
+
+        std::vector<int> codes(cells, 0);
+        Table table(cells);
+        size_t emitted = 0;
+
+        while (true) {
+            if (!prune_symmetric || IsCanonical(table)) {
+                callback(table);
+                emitted++;
+            }
+
+            // Следующая комбинация (одометр)
+            size_t pos = 0;
+            while (pos < cells && ++codes[pos] == options) {
+                codes[pos] = 0;
+                table[pos] = DecodeEntry(0);
+                pos++;
+            }
+            if (pos == cells) break;
+            table[pos] = DecodeEntry(codes[pos]);
+        }
+
+        return emitted;
+    }
+
+    /**
+     * Построить таблицу по правилам TransitionManager
+     * @throws std::out_of_range если правило выходит за n состояний / k символов
+     */
+    Table FromTransitionManager(const TransitionManager<int, int>& manager) const {
+        Table table(static_cast<size_t>(states_count_ * symbols_count_));
+        for (const auto& rule : manager.GetAllRules()) {
+            if (rule.from_state < 0 || rule.from_state >= states_count_ ||
+                rule.to_state < 0 || rule.to_state >= states_count_ ||
+                rule.read_symbol < 0 || rule.read_symbol >= symbols_count_ ||
+                rule.write_symbol < 0 || rule.write_symbol >= symbols_count_) {
+                throw std::out_of_range("Правило выходит за пределы перечисляемого класса машин");
+            }
+            if (rule.direction == Direction::STAY) {
+                throw std::invalid_argument("Перечисляемые машины не используют Direction::STAY");
+            }
+            auto& entry = table[Index(rule.from_state, rule.read_symbol)];
+            entry.defined = true;
+            entry.to_state = rule.to_state;
+            entry.write_symbol = rule.write_symbol;
+            entry.direction = rule.direction;
+        }
+        return table;
+    }
+
+    /**
+     * Записать таблицу в TransitionManager (предыдущие правила удаляются)
+     */
+    void ToTransitionManager(const Table& table, TransitionManager<int, int>& manager) const {
+        manager.Clear();
+        for (int s = 0; s < states_count_; ++s) {
+            for (int a = 0; a < symbols_count_; ++a) {
+                const auto& entry = table[Index(s, a)];
+                if (entry.defined) {
+                    manager.AddRule(s, a, entry.to_state, entry.write_symbol, entry.direction);
+                }
+            }
+        }
+    }
+
+    /**
+     * Канонизация набора правил TransitionManager
+     */
+    void CanonicalizeRules(TransitionManager<int, int>& manager) const {
+        ToTransitionManager(Canonicalize(FromTransitionManager(manager)), manager);
+    }
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <cstddef>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPED_FILE_USE_MMAP 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#else
+#define MAPPED_FILE_USE_MMAP 0
+#include <vector>
+#include <fstream>
+#include <iterator>
+#endif
+
+/**
+ * Файл, отображённый в память (только для чтения или с копированием при записи)
+ * На POSIX-системах используется mmap, страницы подгружаются по обращению;
+ * на остальных платформах файл целиком читается в буфер
+ */
+class MappedFile {
+private:
+    unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+    bool writable_ = false;
+#if MAPPED_FILE_USE_MMAP
+    void* mapping_ = nullptr;
+#else
+    std::vector<unsigned char> buffer_;
+#endif
+
+    MappedFile() = default;
+
+    static std::shared_ptr<MappedFile> Map(const std::string& path, bool writable) {
+        std::shared_ptr<MappedFile> file(new MappedFile());
+        file->writable_ = writable;
+#if MAPPED_FILE_USE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Не удалось открыть файл: " + path);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Не удалось получить размер файла: " + path);
+        }
+        file->size_ = static_cast<size_t>(info.st_size);
+        if (file->size_ > 0) {
+            int protection = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+            void* mapping = ::mmap(nullptr, file->size_, protection, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Не удалось отобразить файл в память: " + path);
+            }
+            file->mapping_ = mapping;
+            file->data_ = static_cast<unsigned char*>(mapping);
+        }
+        ::close(fd);   // Отображение остаётся действительным
+#else
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Не удалось открыть файл: " + path);
+        }
+        file->buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        file->data_ = file->buffer_.data();
+        file->size_ = file->buffer_.size();
+#endif
+        return file;
+    }
+
+public:
+    /**
+     * Отобразить файл только для чтения
+     * @throws std::runtime_error если файл не открывается или не отображается
+     */
+    static std::shared_ptr<const MappedFile> Open(const std::string& path) {
+        return Map(path, false);
+    }
+
+    /**
+     * Отобразить файл с копированием при записи: изменения видны только
+     * этому отображению и в файл не попадают
+     */
+    static std::shared_ptr<MappedFile> OpenCopyOnWrite(const std::string& path) {
+        return Map(path, true);
+    }
+
+    ~MappedFile() {
+#if MAPPED_FILE_USE_MMAP
+        if (mapping_) {
+            ::munmap(mapping_, size_);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* Data() const {
+        return data_;
+    }
+
+    /**
+     * Изменяемые данные (только для отображения с копированием при записи)
+     */
+    unsigned char* MutableData() {
+        if (!writable_) {
+            throw std::logic_error("Файл отображён только для чтения");
+        }
+        return data_;
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+};
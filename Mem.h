@@ -1,9 +1,19 @@
 #pragma once
 
 #include "../ArraySeq.h"
+#include "MappedFile.h"
 
 #include <optional>
 #include <functional>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <type_traits>
 
 template <typename T>
 class ArraySeqMem {
@@ -43,7 +53,194 @@ public:
         return cache_.size(); 
     }
 
+    /**
+     * Байт под элементами кеша
+     */
+    size_t GetMemoryBytes() const noexcept {
+        return cache_.size() * sizeof(T);
+    }
+
+    /**
+     * Указатель на элемент i; элементы [i, MaterializedCount()) лежат подряд
+     */
+    const T* Data(size_t i) const {
+        return &cache_.at(i);
+    }
+
     void Clear() { 
         cache_.clear(); 
     }
 };
+
+/**
+ * Заголовок файла сохранённого Mem; элементы лежат сразу за ним
+ * (64 байта - данные выровнены для любого T с alignof(T) <= 64)
+ */
+struct MemFileHeader {
+    static constexpr uint32_t MAGIC = 0x4D51534C;   // "LSQM"
+    static constexpr uint32_t VERSION = 1;
+
+    uint32_t magic = MAGIC;
+    uint32_t version = VERSION;
+    uint64_t element_size = 0;
+    uint64_t count = 0;
+    uint8_t reserved[40] = {};
+};
+static_assert(sizeof(MemFileHeader) == 64, "Заголовок Mem должен занимать 64 байта");
+
+/**
+ * Сохранить материализованный префикс Mem в файл
+ * Элементы пишутся как есть, поэтому T должен быть тривиально копируемым;
+ * файл читается на той же архитектуре
+ * @throws std::runtime_error при ошибке записи
+ */
+template <typename T, typename Mem>
+void SaveMem(const Mem& mem, const std::string& path) {
+    static_assert(std::is_trivially_copyable_v<T>, "Сохраняются только тривиально копируемые элементы");
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Не удалось открыть файл для записи: " + path);
+    }
+    MemFileHeader header;
+    header.element_size = sizeof(T);
+    header.count = mem.MaterializedCount();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // Пишем пачками, чтобы не зависеть от внутреннего устройства Mem
+    constexpr size_t BATCH = 1 << 14;
+    std::vector<T> batch;
+    batch.reserve(BATCH);
+    for (size_t i = 0; i < header.count; ++i) {
+        batch.push_back(mem.Get(i)->get());
+        if (batch.size() == BATCH || i + 1 == header.count) {
+            out.write(reinterpret_cast<const char*>(batch.data()), static_cast<std::streamsize>(batch.size() * sizeof(T)));
+            batch.clear();
+        }
+    }
+    if (!out) {
+        throw std::runtime_error("Ошибка записи в файл: " + path);
+    }
+}
+
+/**
+ * Mem с префиксом, загруженным из файла через mmap
+ * Загрузка не читает данные: страницы подгружаются при первом обращении,
+ * так что стоимость старта не зависит от размера префикса. Отображение
+ * с копированием при записи, поэтому элементы префикса можно менять без
+ * изменения файла. Новые элементы дописываются в обычную память.
+ * Копия переносит префикс в обычную память
+ */
+template <typename T>
+class MappedSeqMem {
+    static_assert(std::is_trivially_copyable_v<T>, "Отображаются только тривиально копируемые элементы");
+
+private:
+    std::shared_ptr<MappedFile> file_;
+    T* prefix_ = nullptr;
+    size_t prefix_size_ = 0;
+    std::vector<T> tail_;
+
+public:
+    MappedSeqMem() = default;
+
+    /**
+     * Загрузить префикс, сохранённый SaveMem
+     * @throws std::runtime_error если файл повреждён или сохранён для другого типа
+     */
+    static MappedSeqMem Load(const std::string& path) {
+        MappedSeqMem mem;
+        mem.file_ = MappedFile::OpenCopyOnWrite(path);
+
+        MemFileHeader header;
+        if (mem.file_->Size() < sizeof(header)) {
+            throw std::runtime_error("Файл Mem обрезан: " + path);
+        }
+        std::memcpy(&header, mem.file_->Data(), sizeof(header));
+        if (header.magic != MemFileHeader::MAGIC || header.version != MemFileHeader::VERSION) {
+            throw std::runtime_error("Неизвестный формат файла Mem: " + path);
+        }
+        if (header.element_size != sizeof(T)) {
+            throw std::runtime_error("Файл Mem сохранён для элементов другого размера: " + path);
+        }
+        if (header.count > (mem.file_->Size() - sizeof(header)) / sizeof(T)) {
+            throw std::runtime_error("Файл Mem обрезан: " + path);
+        }
+
+        mem.prefix_ = reinterpret_cast<T*>(mem.file_->MutableData() + sizeof(header));
+        mem.prefix_size_ = static_cast<size_t>(header.count);
+        return mem;
+    }
+
+    MappedSeqMem(const MappedSeqMem& other) : tail_(other.prefix_, other.prefix_ + other.prefix_size_) {
+        tail_.insert(tail_.end(), other.tail_.begin(), other.tail_.end());
+    }
+
+    MappedSeqMem& operator=(const MappedSeqMem& other) {
+        if (this != &other) {
+            MappedSeqMem copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    MappedSeqMem(MappedSeqMem&&) noexcept = default;
+    MappedSeqMem& operator=(MappedSeqMem&&) noexcept = default;
+
+    std::optional<std::reference_wrapper<T>> Get(size_t i) noexcept {
+        if (i < prefix_size_) {
+            return std::ref(prefix_[i]);
+        }
+        if (i - prefix_size_ < tail_.size()) {
+            return std::ref(tail_[i - prefix_size_]);
+        }
+        return std::nullopt;
+    }
+
+    std::optional<std::reference_wrapper<const T>> Get(size_t i) const noexcept {
+        if (i < prefix_size_) {
+            return std::cref(prefix_[i]);
+        }
+        if (i - prefix_size_ < tail_.size()) {
+            return std::cref(tail_[i - prefix_size_]);
+        }
+        return std::nullopt;
+    }
+
+    bool Has(size_t i) const noexcept {
+        return i < MaterializedCount();
+    }
+
+    void Append(const T& t) {
+        tail_.push_back(t);
+    }
+
+    void Append(T&& t) {
+        tail_.push_back(std::move(t));
+    }
+
+    size_t MaterializedCount() const noexcept {
+        return prefix_size_ + tail_.size();
+    }
+
+    /**
+     * Байт в куче (хвост); отображённый префикс лежит в страничном кеше файла
+     */
+    size_t GetMemoryBytes() const noexcept {
+        return tail_.capacity() * sizeof(T);
+    }
+
+    /**
+     * Сколько элементов взято из файла
+     */
+    size_t LoadedCount() const noexcept {
+        return prefix_size_;
+    }
+
+    void Clear() {
+        file_.reset();
+        prefix_ = nullptr;
+        prefix_size_ = 0;
+        tail_.clear();
+    }
+};
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <memory>
+#include <cstddef>
+#include <iostream>
+#include <type_traits>
+
+/**
+ * Счётчик байт, выделенных через TrackingAllocator
+ */
+struct AllocationTracker {
+    size_t bytes = 0;
+    size_t allocations = 0;   // Живых блоков
+};
+
+/**
+ * Аллокатор, ведущий учёт живых байт контейнера
+ * Копии аллокатора (в том числе перепривязанные к узлам и корзинам
+ * хеш-таблицы) делят один счётчик, поэтому размер контейнера со всеми
+ * служебными структурами известен за O(1). Копия контейнера получает
+ * собственный счётчик, перемещённый контейнер продолжает вести прежний.
+ * Не потокобезопасен, как и сами контейнеры
+ */
+template <typename T>
+class TrackingAllocator {
+private:
+    std::shared_ptr<AllocationTracker> tracker_;
+
+    template <typename U>
+    friend class TrackingAllocator;
+
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    TrackingAllocator() : tracker_(std::make_shared<AllocationTracker>()) {}
+
+    // Только копирование: перемещённый контейнер должен остаться с рабочим счётчиком
+    TrackingAllocator(const TrackingAllocator&) = default;
+    TrackingAllocator& operator=(const TrackingAllocator&) = default;
+
+    template <typename U>
+    TrackingAllocator(const TrackingAllocator<U>& other) noexcept : tracker_(other.tracker_) {}
+
+    T* allocate(size_t count) {
+        T* pointer = std::allocator<T>().allocate(count);
+        tracker_->bytes += count * sizeof(T);
+        tracker_->allocations++;
+        return pointer;
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept {
+        std::allocator<T>().deallocate(pointer, count);
+        tracker_->bytes -= count * sizeof(T);
+        tracker_->allocations--;
+    }
+
+    /**
+     * Копия контейнера считается отдельно от оригинала
+     */
+    TrackingAllocator select_on_container_copy_construction() const {
+        return TrackingAllocator();
+    }
+
+    /**
+     * Живых байт, выделенных контейнером
+     */
+    size_t GetAllocatedBytes() const {
+        return tracker_->bytes;
+    }
+
+    size_t GetAllocationsCount() const {
+        return tracker_->allocations;
+    }
+
+    template <typename U>
+    bool operator==(const TrackingAllocator<U>& other) const noexcept {
+        return tracker_ == other.tracker_;
+    }
+
+    template <typename U>
+    bool operator!=(const TrackingAllocator<U>& other) const noexcept {
+        return tracker_ != other.tracker_;
+    }
+};
+
+/**
+ * Разбивка памяти машины по назначению (байт)
+ */
+struct MemoryFootprint {
+    size_t tape_base = 0;      // Исходное содержимое ленты (вход, массивы ячеек)
+    size_t tape_overlay = 0;   // Записанные поверх ячейки и их индексы
+    size_t memo = 0;           // Кеш материализованных элементов ленивой последовательности
+    size_t rules = 0;          // Таблица правил переходов
+    size_t metadata = 0;       // Объекты компонентов, конечные состояния, статистика
+
+    size_t GetTotal() const {
+        return tape_base + tape_overlay + memo + rules + metadata;
+    }
+
+    MemoryFootprint& operator+=(const MemoryFootprint& other) {
+        tape_base += other.tape_base;
+        tape_overlay += other.tape_overlay;
+        memo += other.memo;
+        rules += other.rules;
+        metadata += other.metadata;
+        return *this;
+    }
+
+    void Print(std::ostream& out = std::cout) const {
+        out << "=== Память ===" << std::endl;
+        out << "Лента (основа): " << tape_base << " байт" << std::endl;
+        out << "Лента (записи): " << tape_overlay << " байт" << std::endl;
+        out << "Кеш последовательности: " << memo << " байт" << std::endl;
+        out << "Правила: " << rules << " байт" << std::endl;
+        out << "Служебные данные: " << metadata << " байт" << std::endl;
+        out << "Всего: " << GetTotal() << " байт" << std::endl;
+    }
+};
@@ -0,0 +1,582 @@
+#pragma once
+
+#include "MT.h"
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+/**
+ * Способ перебора ветвей недетерминированной машины
+ */
+enum class ExplorationMode {
+    BREADTH_FIRST,        // Поиск в ширину: кратчайшая ветвь, память растёт с фронтом
+    ITERATIVE_DEEPENING   // Параллельный поиск в глубину с итеративным углублением
+};
+
+/**
+ * Итог перебора
+ */
+enum class ExplorationVerdict {
+    ACCEPTED,     // Найдена ветвь, приходящая в конечное состояние
+    REJECTED,     // Достижимые конфигурации исчерпаны, ни одна не конечная
+    DEPTH_LIMIT   // Достигнут предел глубины, ответа нет
+};
+
+struct ExplorationOptions {
+    ExplorationMode mode = ExplorationMode::ITERATIVE_DEEPENING;
+    size_t max_depth = 10000;                 // Предел числа шагов ветви
+    size_t initial_depth = 16;                // Первый предел углубления (дальше удваивается)
+    size_t threads = 0;                       // 0 - по числу ядер
+    /**
+     * Ячеек таблицы транспозиций (по 8 байт). В слишком малой таблице
+     * вытесняются записи предков, и IDDFS может вернуть DEPTH_LIMIT там,
+     * где BFS даёт REJECTED
+     */
+    size_t transposition_entries = 1 << 20;
+};
+
+template <typename State, typename Symbol>
+struct ExplorationResult {
+    ExplorationVerdict verdict = ExplorationVerdict::DEPTH_LIMIT;
+    std::vector<TransitionRule<State, Symbol>> path;   // Правила принимающей ветви
+    size_t iterations = 0;          // Итераций углубления (для BFS - уровней)
+    size_t explored = 0;            // Посещённых конфигураций
+    size_t transposition_hits = 0;  // Ветвей, отсечённых таблицей транспозиций
+    size_t steals = 0;              // Украденных поддеревьев
+    size_t peak_frontier = 0;       // Наибольший фронт поиска в ширину
+};
+
+namespace nondeterministic_detail {
+
+inline uint64_t Mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * Лента ветви поиска с инкрементальным хешем
+ * Хеш - XOR хешей непустых ячеек (позиция, символ), поэтому запись
+ * обновляет его за O(1), а одинаковые ленты имеют одинаковый хеш
+ * независимо от истории
+ */
+template <typename Symbol>
+class SearchTape {
+private:
+    std::vector<Symbol> cells_;
+    long long origin_ = 0;   // Позиция p лежит в cells_[origin_ + p]
+    Symbol blank_;
+    uint64_t hash_ = 0;
+
+    static uint64_t CellHash(long long position, const Symbol& symbol) {
+        return Mix(static_cast<uint64_t>(position) * 0x9e3779b97f4a7c15ULL ^ std::hash<Symbol>{}(symbol));
+    }
+
+public:
+    SearchTape(const Symbol& blank, const std::vector<Symbol>& input) : cells_(input), blank_(blank) {
+        for (size_t i = 0; i < input.size(); ++i) {
+            if (!(input[i] == blank_)) hash_ ^= CellHash(static_cast<long long>(i), input[i]);
+        }
+    }
+
+    const Symbol& Get(long long position) const {
+        long long index = position + origin_;
+        if (index < 0 || index >= static_cast<long long>(cells_.size())) return blank_;
+        return cells_[static_cast<size_t>(index)];
+    }
+
+    void Set(long long position, const Symbol& symbol) {
+        if (position + origin_ < 0) {
+            size_t grow = std::max<size_t>(static_cast<size_t>(-(position + origin_)), std::max<size_t>(cells_.size(), 16));
+            cells_.insert(cells_.begin(), grow, blank_);
+            origin_ += static_cast<long long>(grow);
+        } else if (position + origin_ >= static_cast<long long>(cells_.size())) {
+            cells_.resize(std::max<size_t>(static_cast<size_t>(position + origin_) + 1, cells_.size() * 2), blank_);
+        }
+        Symbol& cell = cells_[static_cast<size_t>(position + origin_)];
+        if (!(cell == blank_)) hash_ ^= CellHash(position, cell);
+        if (!(symbol == blank_)) hash_ ^= CellHash(position, symbol);
+        cell = symbol;
+    }
+
+    uint64_t GetHash() const {
+        return hash_;
+    }
+};
+
+/**
+ * Ограниченная таблица транспозиций
+ * Ячейка - одно 64-битное слово: старшие 40 бит - отпечаток хеша
+ * конфигурации, младшие 24 - остаток глубины, до которого конфигурация уже
+ * исследуется или исследована (EXHAUSTED - все ветви из неё остановились,
+ * не упёршись в предел). Таблица прямого отображения с вытеснением:
+ * потеря записи о законченной конфигурации стоит повторного обхода, но
+ * потеря записи предка, обход которого ещё идёт, скрывает цикл - ветвь
+ * крутится до предела глубины, и вердикт REJECTED может смениться на
+ * DEPTH_LIMIT (ACCEPTED не теряется). Ложное совпадение отпечатков
+ * (вероятность порядка 2^-40 на обращение) может отсечь ветвь
+ */
+class TranspositionTable {
+private:
+    std::unique_ptr<std::atomic<uint64_t>[]> entries_;
+    size_t mask_;
+
+    static constexpr uint64_t DEPTH_BITS = 24;
+    static constexpr uint64_t DEPTH_MASK = (uint64_t{1} << DEPTH_BITS) - 1;
+
+    static uint64_t Fingerprint(uint64_t hash) {
+        return (hash & ~DEPTH_MASK) | (uint64_t{1} << 63);
+    }
+
+public:
+    static constexpr uint32_t EXHAUSTED = static_cast<uint32_t>(DEPTH_MASK);
+    static constexpr uint32_t MAX_REMAINING = EXHAUSTED - 1;
+
+    explicit TranspositionTable(size_t entries) {
+        size_t rounded = 1;
+        while (rounded < std::max<size_t>(entries, 1)) rounded <<= 1;
+        entries_.reset(new std::atomic<uint64_t>[rounded]);
+        for (size_t i = 0; i < rounded; ++i) {
+            entries_[i].store(0, std::memory_order_relaxed);
+        }
+        mask_ = rounded - 1;
+    }
+
+    /**
+     * Остаток глубины, записанный для конфигурации (0, если записи нет)
+     */
+    uint32_t Probe(uint64_t hash) const {
+        uint64_t entry = entries_[Mix(hash) & mask_].load(std::memory_order_relaxed);
+        if ((entry & ~DEPTH_MASK) != Fingerprint(hash)) return 0;
+        return static_cast<uint32_t>(entry & DEPTH_MASK);
+    }
+
+    void Store(uint64_t hash, uint32_t remaining) {
+        auto& slot = entries_[Mix(hash) & mask_];
+        uint64_t entry = slot.load(std::memory_order_relaxed);
+        if ((entry & ~DEPTH_MASK) == Fingerprint(hash) && (entry & DEPTH_MASK) >= remaining) return;
+        slot.store(Fingerprint(hash) | remaining, std::memory_order_relaxed);
+    }
+
+    size_t GetMemoryBytes() const {
+        return (mask_ + 1) * sizeof(uint64_t);
+    }
+};
+
+}  // namespace nondeterministic_detail
+
+/**
+ * Перебор ветвей недетерминированной машины Тьюринга
+ * Машина принимает вход, если хотя бы одна ветвь приходит в конечное
+ * состояние; ветвь без правила для текущего символа останавливается.
+ *
+ * Поиск в ширину хранит весь фронт и все посещённые конфигурации, поэтому
+ * память растёт экспоненциально с глубиной. Поиск в глубину с итеративным
+ * углублением держит в памяти только путь до текущей конфигурации
+ * (запись отменяется при возврате) и таблицу транспозиций фиксированного
+ * размера, которая отсекает повторные и циклические конфигурации. Пределы
+ * глубины удваиваются от initial_depth до max_depth.
+ *
+ * Потоки работают над общим деревом с кражей работы: у каждого потока своя
+ * дека поддеревьев; пока есть простаивающие потоки, альтернативы узла
+ * выносятся в деку как отдельные задания (копия ленты и пути), свободный
+ * поток крадёт самое старое, то есть самое крупное, поддерево.
+ * Найденная ветвь - не обязательно кратчайшая (кратчайшую даёт поиск в ширину)
+ */
+template <typename State, typename Symbol>
+class NondeterministicExplorer {
+public:
+    using Rule = TransitionRule<State, Symbol>;
+
+private:
+    using Tape = nondeterministic_detail::SearchTape<Symbol>;
+    using RuleKey = std::pair<State, Symbol>;
+
+    struct KeyHasher {
+        size_t operator()(const RuleKey& key) const {
+            return std::hash<State>{}(key.first) * 31 + std::hash<Symbol>{}(key.second);
+        }
+    };
+
+    std::unordered_map<RuleKey, std::vector<Rule>, KeyHasher> choices_;
+    std::unordered_set<State> final_states_;
+    State initial_state_;
+    Symbol blank_symbol_;
+
+    /**
+     * Поддерево, ожидающее обхода
+     */
+    struct Task {
+        State state;
+        long long head;
+        Tape tape;
+        std::vector<Rule> path;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    /**
+     * Общие данные одной итерации углубления
+     */
+    struct Search {
+        size_t limit;
+        nondeterministic_detail::TranspositionTable& table;
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+        std::atomic<size_t> pending{0};      // Заданий в деках и в работе
+        std::atomic<size_t> idle{0};         // Потоков без работы
+        std::atomic<bool> accepted{false};
+        std::atomic<bool> cut_off{false};    // Какая-то ветвь упёрлась в предел
+        std::atomic<size_t> explored{0};
+        std::atomic<size_t> transposition_hits{0};
+        std::atomic<size_t> steals{0};
+        std::mutex result_mutex;
+        std::vector<Rule> accepting_path;
+
+        Search(size_t depth_limit, nondeterministic_detail::TranspositionTable& transpositions, size_t threads)
+            : limit(depth_limit), table(transpositions) {
+            for (size_t t = 0; t < threads; ++t) {
+                queues.push_back(std::make_unique<WorkerQueue>());
+            }
+        }
+    };
+
+    static uint64_t ConfigurationHash(const State& state, long long head, const Tape& tape) {
+        using nondeterministic_detail::Mix;
+        return tape.GetHash() ^ Mix(std::hash<State>{}(state) + 0x632be59bd9b4e019ULL) ^
+               Mix(static_cast<uint64_t>(head) + 0x8cb92ba72f3d8dd7ULL);
+    }
+
+    const std::vector<Rule>* FindChoices(const State& state, const Symbol& symbol) const {
+        auto it = choices_.find(RuleKey(state, symbol));
+        return it != choices_.end() ? &it->second : nullptr;
+    }
+
+    bool TakeTask(Search& search, size_t self, Task& task) const {
+        {
+            WorkerQueue& own = *search.queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        for (size_t offset = 1; offset < search.queues.size(); ++offset) {
+            WorkerQueue& victim = *search.queues[(self + offset) % search.queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                search.steals.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Обход поддерева в глубину до предела search.limit
+     * Итеративный: глубина стека вызовов не зависит от глубины поиска
+     */
+    void ExploreTask(Search& search, size_t self, Task task) const {
+        using nondeterministic_detail::TranspositionTable;
+
+        struct Frame {
+            const std::vector<Rule>* choices;
+            size_t next;
+            uint64_t hash;
+            bool incomplete;   // Поддерево обойдено не целиком этим потоком
+        };
+        struct Undo {
+            State state;
+            long long head;
+            Symbol symbol;
+        };
+
+        State state = std::move(task.state);
+        long long head = task.head;
+        Tape tape = std::move(task.tape);
+        std::vector<Rule> path = std::move(task.path);
+        std::vector<Frame> frames;
+        std::vector<Undo> undo;
+        size_t explored = 0;
+        size_t hits = 0;
+
+        // Войти в текущую конфигурацию; true - у неё есть ходы и она на стеке
+        auto enter = [&]() {
+            explored++;
+            if (final_states_.count(state) != 0) {
+                std::lock_guard<std::mutex> lock(search.result_mutex);
+                if (!search.accepted.load(std::memory_order_relaxed)) {
+                    search.accepting_path = path;
+                    search.accepted.store(true, std::memory_order_release);
+                }
+                return false;
+            }
+            const auto* choices = FindChoices(state, tape.Get(head));
+            if (!choices) {
+                return false;   // Ветвь остановилась
+            }
+            if (path.size() >= search.limit) {
+                search.cut_off.store(true, std::memory_order_relaxed);
+                if (!frames.empty()) frames.back().incomplete = true;
+                return false;
+            }
+
+            // Конфигурация уже исследуется с не меньшим остатком глубины - её
+            // поддерево обходит кто-то другой (или предок на этом же пути)
+            uint64_t hash = ConfigurationHash(state, head, tape);
+            uint32_t remaining = static_cast<uint32_t>(search.limit - path.size());
+            uint32_t known = search.table.Probe(hash);
+            if (known >= remaining) {
+                hits++;
+                if (known != TranspositionTable::EXHAUSTED && !frames.empty()) frames.back().incomplete = true;
+                return false;
+            }
+            search.table.Store(hash, remaining);
+            frames.push_back({choices, 0, hash, false});
+            return true;
+        };
+        auto apply = [&](const Rule& rule) {
+            undo.push_back({state, head, tape.Get(head)});
+            tape.Set(head, rule.write_symbol);
+            head += static_cast<int>(rule.direction);
+            state = rule.to_state;
+            path.push_back(rule);
+        };
+        auto revert = [&]() {
+            state = undo.back().state;
+            head = undo.back().head;
+            tape.Set(head, undo.back().symbol);
+            undo.pop_back();
+            path.pop_back();
+        };
+
+        if (enter()) {
+            while (!frames.empty() && !search.accepted.load(std::memory_order_relaxed)) {
+                Frame& frame = frames.back();
+                if (frame.next == frame.choices->size()) {
+                    if (!frame.incomplete) {
+                        search.table.Store(frame.hash, TranspositionTable::EXHAUSTED);
+                    }
+                    bool incomplete = frame.incomplete;
+                    frames.pop_back();
+                    if (!frames.empty()) {
+                        frames.back().incomplete |= incomplete;
+                        revert();
+                    }
+                    continue;
+                }
+
+                const Rule& rule = (*frame.choices)[frame.next++];
+                if (frame.next < frame.choices->size() && search.idle.load(std::memory_order_relaxed) > 0) {
+                    // Есть простаивающие потоки: остальные варианты отдаются им
+                    WorkerQueue& own = *search.queues[self];
+                    std::lock_guard<std::mutex> lock(own.mutex);
+                    if (own.tasks.size() < 2) {
+                        search.pending.fetch_add(frame.choices->size() - frame.next, std::memory_order_relaxed);
+                        for (; frame.next < frame.choices->size(); ++frame.next) {
+                            const Rule& alternative = (*frame.choices)[frame.next];
+                            Task stolen{alternative.to_state, head + static_cast<int>(alternative.direction), tape, path};
+                            stolen.tape.Set(head, alternative.write_symbol);
+                            stolen.path.push_back(alternative);
+                            own.tasks.push_back(std::move(stolen));
+                        }
+                        frame.incomplete = true;
+                    }
+                }
+                apply(rule);
+                if (!enter()) {
+                    revert();
+                }
+            }
+        }
+
+        search.explored.fetch_add(explored, std::memory_order_relaxed);
+        search.transposition_hits.fetch_add(hits, std::memory_order_relaxed);
+    }
+
+    void Work(Search& search, size_t self) const {
+        bool idle = false;
+        while (!search.accepted.load(std::memory_order_acquire)) {
+            Task task{initial_state_, 0, Tape(blank_symbol_, {}), {}};
+            if (TakeTask(search, self, task)) {
+                if (idle) {
+                    search.idle.fetch_sub(1, std::memory_order_relaxed);
+                    idle = false;
+                }
+                ExploreTask(search, self, std::move(task));
+                search.pending.fetch_sub(1, std::memory_order_acq_rel);
+                continue;
+            }
+            if (search.pending.load(std::memory_order_acquire) == 0) break;
+            if (!idle) {
+                search.idle.fetch_add(1, std::memory_order_relaxed);
+                idle = true;
+            }
+            std::this_thread::yield();
+        }
+        if (idle) {
+            search.idle.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    ExplorationResult<State, Symbol> IterativeDeepening(const std::vector<Symbol>& input,
+                                                        const ExplorationOptions& options) const {
+        using nondeterministic_detail::TranspositionTable;
+        ExplorationResult<State, Symbol> result;
+        size_t threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+        size_t max_depth = std::min<size_t>(options.max_depth, TranspositionTable::MAX_REMAINING);
+        TranspositionTable table(options.transposition_entries);
+
+        size_t limit = std::min(std::max<size_t>(options.initial_depth, 1), max_depth);
+        while (true) {
+            TraceSpan span("search", "deepening iteration");
+            span.SetArg("limit", static_cast<long long>(limit));
+            Search search(limit, table, threads);
+            search.queues[0]->tasks.push_back({initial_state_, 0, Tape(blank_symbol_, input), {}});
+            search.pending.store(1);
+
+            std::vector<std::thread> workers;
+            for (size_t t = 1; t < threads; ++t) {
+                workers.emplace_back([this, &search, t]() { Work(search, t); });
+            }
+            Work(search, 0);
+            for (auto& worker : workers) {
+                worker.join();
+            }
+
+            result.iterations++;
+            result.explored += search.explored.load();
+            result.transposition_hits += search.transposition_hits.load();
+            result.steals += search.steals.load();
+            if (search.accepted.load()) {
+                result.verdict = ExplorationVerdict::ACCEPTED;
+                result.path = std::move(search.accepting_path);
+                return result;
+            }
+            if (!search.cut_off.load()) {
+                result.verdict = ExplorationVerdict::REJECTED;
+                return result;
+            }
+            if (limit >= max_depth) {
+                result.verdict = ExplorationVerdict::DEPTH_LIMIT;
+                return result;
+            }
+            limit = std::min(limit * 2, max_depth);
+        }
+    }
+
+    ExplorationResult<State, Symbol> BreadthFirst(const std::vector<Symbol>& input,
+                                                  const ExplorationOptions& options) const {
+        // Узел хранит полную конфигурацию и ссылку на родителя для восстановления пути
+        struct Node {
+            State state;
+            long long head;
+            Tape tape;
+            size_t parent;
+            Rule rule;
+        };
+        ExplorationResult<State, Symbol> result;
+        std::vector<Node> nodes;
+        std::unordered_set<uint64_t> visited;
+        std::vector<size_t> frontier;
+
+        nodes.push_back({initial_state_, 0, Tape(blank_symbol_, input), 0, Rule()});
+        visited.insert(ConfigurationHash(initial_state_, 0, nodes[0].tape));
+        frontier.push_back(0);
+
+        for (size_t depth = 0; !frontier.empty(); ++depth) {
+            result.iterations++;
+            result.peak_frontier = std::max(result.peak_frontier, frontier.size());
+            std::vector<size_t> next;
+            bool truncated = false;
+            for (size_t index : frontier) {
+                result.explored++;
+                if (final_states_.count(nodes[index].state) != 0) {
+                    result.verdict = ExplorationVerdict::ACCEPTED;
+                    for (size_t node = index; node != 0; node = nodes[node].parent) {
+                        result.path.push_back(nodes[node].rule);
+                    }
+                    std::reverse(result.path.begin(), result.path.end());
+                    return result;
+                }
+                const auto* choices = FindChoices(nodes[index].state, nodes[index].tape.Get(nodes[index].head));
+                if (!choices) continue;
+                if (depth >= options.max_depth) {
+                    truncated = true;
+                    continue;
+                }
+                for (const auto& rule : *choices) {
+                    Node child{rule.to_state, nodes[index].head + static_cast<int>(rule.direction),
+                               nodes[index].tape, index, rule};
+                    child.tape.Set(nodes[index].head, rule.write_symbol);
+                    if (visited.insert(ConfigurationHash(child.state, child.head, child.tape)).second) {
+                        nodes.push_back(std::move(child));
+                        next.push_back(nodes.size() - 1);
+                    }
+                }
+            }
+            if (truncated) {
+                result.verdict = ExplorationVerdict::DEPTH_LIMIT;
+                return result;
+            }
+            frontier = std::move(next);
+        }
+        result.verdict = ExplorationVerdict::REJECTED;
+        return result;
+    }
+
+public:
+    /**
+     * @param transitions Правила вместе с альтернативными вариантами
+     */
+    NondeterministicExplorer(const TransitionManager<State, Symbol>& transitions,
+                             const State& initial_state,
+                             const Symbol& blank_symbol,
+                             const std::vector<State>& final_states)
+        : final_states_(final_states.begin(), final_states.end()),
+          initial_state_(initial_state),
+          blank_symbol_(blank_symbol) {
+        for (const auto& rule : transitions.GetAllRules()) {
+            choices_[RuleKey(rule.from_state, rule.read_symbol)] = transitions.FindRules(rule.from_state, rule.read_symbol);
+        }
+    }
+
+    /**
+     * Перебор по правилам и состояниям настроенной машины
+     */
+    template <typename Storage>
+    static NondeterministicExplorer FromMachine(const TuringMachine<State, Symbol, Storage>& machine) {
+        const auto& finals = machine.GetStateManager().GetFinalStates();
+        return NondeterministicExplorer(machine.GetTransitionManager(), machine.GetInitialState(),
+                                        machine.GetBlankSymbol(), std::vector<State>(finals.begin(), finals.end()));
+    }
+
+    /**
+     * Перебрать ветви на входе input (головка в позиции 0)
+     */
+    ExplorationResult<State, Symbol> Explore(const std::vector<Symbol>& input,
+                                             const ExplorationOptions& options = ExplorationOptions()) const {
+        if (options.mode == ExplorationMode::BREADTH_FIRST) {
+            return BreadthFirst(input, options);
+        }
+        return IterativeDeepening(input, options);
+    }
+};
@@ -0,0 +1,294 @@
+#pragma once
+
+#include "TuringStrip.h"
+#include "LazySeq.h"
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <type_traits>
+
+/**
+ * Признак хранилища из блоков фиксированного размера (CHUNK_SIZE)
+ */
+template <typename Storage, typename = void>
+struct HasChunkSize : std::false_type {};
+
+template <typename Storage>
+struct HasChunkSize<Storage, std::void_t<decltype(Storage::CHUNK_SIZE)>> : std::true_type {};
+
+/**
+ * Параллельные свёртки по отрезкам ленты и LazySeq
+ * Отрезок режется на блоки по сетке, выровненной по абсолютным позициям
+ * (и по блокам хранилища, если они есть). Блоки сворачиваются в потоках,
+ * частичные результаты объединяются последовательно в порядке блоков.
+ * Разбиение не зависит от числа потоков, поэтому для ассоциативной операции
+ * результат совпадает с последовательной свёрткой слева направо;
+ * коммутативность и нейтральный элемент не требуются. Операции вызываются
+ * из нескольких потоков одновременно
+ */
+class ParallelReducer {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 1 << 16;
+
+private:
+    size_t threads_count_;
+    size_t block_size_;
+
+    static long long FloorDiv(long long value, long long divisor) {
+        return value >= 0 ? value / divisor : -((-value - 1) / divisor) - 1;
+    }
+
+    /**
+     * Применить block_fn(begin, end) ко всем блокам [first, end)
+     * @return Результаты блоков в порядке позиций
+     */
+    template <typename R, typename BlockFn>
+    std::vector<R> MapBlocks(long long first, long long end, size_t block_size, BlockFn block_fn) const {
+        if (first >= end) {
+            return {};
+        }
+        long long block = static_cast<long long>(block_size);
+        long long first_block = FloorDiv(first, block);
+        size_t blocks_count = static_cast<size_t>(FloorDiv(end - 1, block) - first_block + 1);
+
+        std::vector<R> results(blocks_count);
+        std::atomic<size_t> next_block{0};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        auto worker = [&]() {
+            for (size_t k = next_block.fetch_add(1); k < blocks_count; k = next_block.fetch_add(1)) {
+                long long begin = std::max(first, (first_block + static_cast<long long>(k)) * block);
+                long long stop = std::min(end, (first_block + static_cast<long long>(k) + 1) * block);
+                try {
+                    results[k] = block_fn(begin, stop);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error) error = std::current_exception();
+                    next_block.store(blocks_count);
+                }
+            }
+        };
+
+        // Текущий поток тоже работает
+        size_t threads_count = std::min(threads_count_, blocks_count);
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < threads_count; ++i) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return results;
+    }
+
+    template <typename Storage>
+    size_t BlockSizeFor() const {
+        if constexpr (HasChunkSize<Storage>::value) {
+            size_t chunk = static_cast<size_t>(Storage::CHUNK_SIZE);
+            return (block_size_ + chunk - 1) / chunk * chunk;
+        } else {
+            return block_size_;
+        }
+    }
+
+    template <typename T, typename ReduceOp>
+    static T Combine(T init, std::vector<std::optional<T>>& partials, ReduceOp& reduce) {
+        for (auto& partial : partials) {
+            if (partial) {
+                init = reduce(std::move(init), std::move(*partial));
+            }
+        }
+        return init;
+    }
+
+    template <typename T, typename ReduceOp, typename TransformOp, typename Iterator>
+    static void FoldInto(std::optional<T>& accumulator, Iterator begin, Iterator end,
+                         ReduceOp& reduce, TransformOp& transform) {
+        if (begin == end) {
+            return;
+        }
+        if (!accumulator) {
+            accumulator = transform(*begin);
+            ++begin;
+        }
+        T value = std::move(*accumulator);
+        for (; begin != end; ++begin) {
+            value = reduce(std::move(value), transform(*begin));
+        }
+        accumulator = std::move(value);
+    }
+
+public:
+    /**
+     * @param threads_count Число потоков (включая вызывающий)
+     * @param block_size Размер блока в ячейках
+     */
+    explicit ParallelReducer(size_t threads_count = std::max(1u, std::thread::hardware_concurrency()),
+                             size_t block_size = DEFAULT_BLOCK_SIZE)
+        : threads_count_(std::max<size_t>(1, threads_count)), block_size_(std::max<size_t>(1, block_size)) {}
+
+    /**
+     * Свёртка reduce(...reduce(reduce(init, transform(s[first])), transform(s[first + 1]))...)
+     * по ячейкам [first, last] ленты
+     */
+    template <typename Symbol, typename Storage, typename T, typename ReduceOp, typename TransformOp>
+    T TransformReduce(const TuringStrip<Symbol, Storage>& strip, int first, int last,
+                      T init, ReduceOp reduce, TransformOp transform) const {
+        strip.PrepareConcurrentReads();
+        auto partials = MapBlocks<std::optional<T>>(
+            first, static_cast<long long>(last) + 1, BlockSizeFor<Storage>(),
+            [&](long long begin, long long stop) {
+                std::vector<Symbol> cells(static_cast<size_t>(stop - begin));
+                strip.ReadSegment(static_cast<int>(begin), cells.size(), cells.data());
+                std::optional<T> accumulator;
+                FoldInto(accumulator, cells.begin(), cells.end(), reduce, transform);
+                return accumulator;
+            });
+        return Combine(std::move(init), partials, reduce);
+    }
+
+    /**
+     * Свёртка по использованному отрезку ленты
+     */
+    template <typename Symbol, typename Storage, typename T, typename ReduceOp, typename TransformOp>
+    T TransformReduce(const TuringStrip<Symbol, Storage>& strip, T init, ReduceOp reduce, TransformOp transform) const {
+        auto [first, last] = strip.GetUsedRange();
+        return TransformReduce(strip, first, last, std::move(init), std::move(reduce), std::move(transform));
+    }
+
+    template <typename Symbol, typename Storage, typename T, typename ReduceOp>
+    T Reduce(const TuringStrip<Symbol, Storage>& strip, int first, int last, T init, ReduceOp reduce) const {
+        return TransformReduce(strip, first, last, std::move(init), std::move(reduce),
+                               [](const Symbol& symbol) { return T(symbol); });
+    }
+
+    /**
+     * Сколько ячеек [first, last] содержат symbol
+     */
+    template <typename Symbol, typename Storage>
+    size_t Count(const TuringStrip<Symbol, Storage>& strip, int first, int last, const Symbol& symbol) const {
+        return TransformReduce(strip, first, last, size_t{0}, std::plus<size_t>(),
+                               [&symbol](const Symbol& cell) { return static_cast<size_t>(cell == symbol); });
+    }
+
+    /**
+     * Первая позиция в [first, last], где выполняется predicate
+     */
+    template <typename Symbol, typename Storage, typename Predicate>
+    std::optional<int> FindFirst(const TuringStrip<Symbol, Storage>& strip, int first, int last,
+                                 Predicate predicate) const {
+        return FindInBlocks(strip, first, last, predicate, false);
+    }
+
+    /**
+     * Последняя позиция в [first, last], где выполняется predicate
+     */
+    template <typename Symbol, typename Storage, typename Predicate>
+    std::optional<int> FindLast(const TuringStrip<Symbol, Storage>& strip, int first, int last,
+                                Predicate predicate) const {
+        return FindInBlocks(strip, first, last, predicate, true);
+    }
+
+    /**
+     * Полиномиальный хеш отрезка [first, last]: h = h * P + hash(s) по всем
+     * ячейкам слева направо, начиная с h = 0 (арифметика по модулю 2^64)
+     */
+    template <typename Symbol, typename Storage>
+    uint64_t Checksum(const TuringStrip<Symbol, Storage>& strip, int first, int last) const {
+        static constexpr uint64_t P = 1099511628211ULL;
+        using Hash = std::pair<uint64_t, uint64_t>;   // (хеш, P^длина)
+        return TransformReduce(strip, first, last, Hash{0, 1},
+            [](const Hash& left, const Hash& right) {
+                return Hash{left.first * right.second + right.first, left.second * right.second};
+            },
+            [](const Symbol& symbol) { return Hash{static_cast<uint64_t>(std::hash<Symbol>{}(symbol)), P}; }).first;
+    }
+
+    /**
+     * Свёртка по элементам [first, last) LazySeq
+     * Генерация последовательна, поэтому недостающие элементы сначала
+     * материализуются в вызывающем потоке; константный хвост не материализуется
+     */
+    template <typename T, typename Generator, typename Mem, typename R, typename ReduceOp, typename TransformOp>
+    R TransformReduce(const LazySeq<T, Generator, Mem>& seq, size_t first, size_t last,
+                      R init, ReduceOp reduce, TransformOp transform) const {
+        last = std::min(last, seq.MaxLen());
+        size_t generated = std::min(last, seq.ImplicitTailStart());
+        if (seq.MaterializeUpTo(generated) < generated) {
+            last = seq.MaterializedCount();   // Генератор иссяк
+        }
+
+        auto partials = MapBlocks<std::optional<R>>(
+            static_cast<long long>(first), static_cast<long long>(std::max(first, last)), block_size_,
+            [&](long long begin, long long stop) {
+                std::optional<R> accumulator;
+                size_t count = static_cast<size_t>(stop - begin);
+                for (auto span : seq.Spans(static_cast<size_t>(begin), static_cast<size_t>(stop), count)) {
+                    FoldInto(accumulator, span.begin(), span.end(), reduce, transform);
+                }
+                return accumulator;
+            });
+        return Combine(std::move(init), partials, reduce);
+    }
+
+    template <typename T, typename Generator, typename Mem, typename R, typename ReduceOp>
+    R Reduce(const LazySeq<T, Generator, Mem>& seq, size_t first, size_t last, R init, ReduceOp reduce) const {
+        return TransformReduce(seq, first, last, std::move(init), std::move(reduce),
+                               [](const T& value) { return R(value); });
+    }
+
+    size_t GetThreadsCount() const {
+        return threads_count_;
+    }
+
+    size_t GetBlockSize() const {
+        return block_size_;
+    }
+
+private:
+    template <typename Symbol, typename Storage, typename Predicate>
+    std::optional<int> FindInBlocks(const TuringStrip<Symbol, Storage>& strip, int first, int last,
+                                    Predicate& predicate, bool from_end) const {
+        strip.PrepareConcurrentReads();
+        auto found = MapBlocks<std::optional<int>>(
+            first, static_cast<long long>(last) + 1, BlockSizeFor<Storage>(),
+            [&](long long begin, long long stop) -> std::optional<int> {
+                std::vector<Symbol> cells(static_cast<size_t>(stop - begin));
+                strip.ReadSegment(static_cast<int>(begin), cells.size(), cells.data());
+                if (from_end) {
+                    for (size_t i = cells.size(); i-- > 0;) {
+                        if (predicate(cells[i])) return static_cast<int>(begin + static_cast<long long>(i));
+                    }
+                } else {
+                    for (size_t i = 0; i < cells.size(); ++i) {
+                        if (predicate(cells[i])) return static_cast<int>(begin + static_cast<long long>(i));
+                    }
+                }
+                return std::nullopt;
+            });
+
+        if (from_end) {
+            for (auto it = found.rbegin(); it != found.rend(); ++it) {
+                if (*it) return *it;
+            }
+        } else {
+            for (const auto& position : found) {
+                if (position) return position;
+            }
+        }
+        return std::nullopt;
+    }
+};
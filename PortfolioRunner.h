@@ -0,0 +1,178 @@
+#pragma once
+
+#include "ExecutionEngines.h"
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <string>
+#include <vector>
+#include <optional>
+#include <condition_variable>
+#include <unordered_map>
+#include <stdexcept>
+
+/**
+ * Результат портфельного запуска
+ */
+template <typename State, typename Symbol>
+struct PortfolioOutcome {
+    EngineOutcome<State, Symbol> outcome;
+    std::string winner;   // Имя движка, давшего результат
+    bool raced = false;   // true - движки соревновались; false - сразу запущен известный победитель
+};
+
+/**
+ * Портфельный запуск
+ * Ответственность: гонка нескольких движков на одной машине и входе.
+ * Побеждает первый завершившийся, остальные отменяются. Победитель
+ * запоминается по отпечатку машины, и повторные запуски идут без гонки
+ */
+template <typename State, typename Symbol>
+class PortfolioRunner {
+public:
+    using Engine = IExecutionEngine<State, Symbol>;
+
+private:
+    std::vector<std::unique_ptr<Engine>> engines_;
+
+    mutable std::mutex winners_mutex_;
+    std::unordered_map<size_t, size_t> winners_;   // отпечаток машины -> индекс движка
+
+    std::optional<size_t> FindWinner(size_t fingerprint) const {
+        std::lock_guard<std::mutex> lock(winners_mutex_);
+        auto it = winners_.find(fingerprint);
+        if (it != winners_.end()) {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
+public:
+    PortfolioRunner() = default;
+
+    /**
+     * Портфель по умолчанию: интерпретатор, chain step и макромашина
+     */
+    static std::unique_ptr<PortfolioRunner> MakeDefault(int macro_block_size = 4) {
+        auto runner = std::make_unique<PortfolioRunner>();
+        runner->AddEngine(std::make_unique<InterpreterEngine<State, Symbol>>());
+        runner->AddEngine(std::make_unique<ChainStepEngine<State, Symbol>>());
+        runner->AddEngine(std::make_unique<MacroMachineEngine<State, Symbol>>(macro_block_size));
+        return runner;
+    }
+
+    void AddEngine(std::unique_ptr<Engine> engine) {
+        engines_.push_back(std::move(engine));
+    }
+
+    size_t GetEnginesCount() const {
+        return engines_.size();
+    }
+
+    /**
+     * Запустить машину
+     * @param force_race Соревноваться даже при известном победителе
+     */
+    PortfolioOutcome<State, Symbol> Run(const MachineDefinition<State, Symbol>& machine,
+                                        const std::vector<Symbol>& input,
+                                        size_t max_steps,
+                                        bool force_race = false) {
+        if (engines_.empty()) {
+            throw std::logic_error("В портфеле нет движков");
+        }
+
+        size_t fingerprint = machine.GetFingerprint();
+        auto known = force_race ? std::nullopt : FindWinner(fingerprint);
+        if (known) {
+            std::atomic<bool> never_cancel{false};
+            PortfolioOutcome<State, Symbol> result;
+            result.outcome = engines_[*known]->Execute(machine, input, max_steps, never_cancel);
+            result.winner = engines_[*known]->GetName();
+            return result;
+        }
+
+        std::atomic<bool> cancel{false};
+        std::mutex finish_mutex;
+        std::condition_variable finished;
+        std::optional<size_t> winner;
+        EngineOutcome<State, Symbol> winning_outcome;
+        size_t failed = 0;
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < engines_.size(); ++i) {
+            threads.emplace_back([&, i]() {
+                EngineOutcome<State, Symbol> outcome;
+                bool ok = true;
+                try {
+                    outcome = engines_[i]->Execute(machine, input, max_steps, cancel);
+                } catch (const std::exception&) {
+                    ok = false;
+                }
+
+                std::lock_guard<std::mutex> lock(finish_mutex);
+                if (ok && !outcome.cancelled && !winner) {
+                    winner = i;
+                    winning_outcome = std::move(outcome);
+                    cancel.store(true, std::memory_order_relaxed);
+                } else if (!ok) {
+                    failed++;
+                }
+                finished.notify_one();
+            });
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(finish_mutex);
+            finished.wait(lock, [&]() { return winner.has_value() || failed == engines_.size(); });
+        }
+        cancel.store(true, std::memory_order_relaxed);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        PortfolioOutcome<State, Symbol> result;
+        result.raced = true;
+        if (!winner) {
+            result.outcome.result = ExecutionResult::ERROR;
+            return result;
+        }
+
+        result.outcome = std::move(winning_outcome);
+        result.winner = engines_[*winner]->GetName();
+        {
+            std::lock_guard<std::mutex> lock(winners_mutex_);
+            winners_[fingerprint] = *winner;
+        }
+        return result;
+    }
+
+    /**
+     * Запустить настроенную машину на её входе
+     */
+    PortfolioOutcome<State, Symbol> Run(const TuringMachine<State, Symbol>& machine,
+                                        const std::vector<Symbol>& input,
+                                        size_t max_steps) {
+        return Run(MachineDefinition<State, Symbol>::FromMachine(machine), input, max_steps);
+    }
+
+    /**
+     * Известный победитель для машины (если гонка уже проводилась)
+     */
+    std::optional<std::string> GetRecordedWinner(const MachineDefinition<State, Symbol>& machine) const {
+        auto known = FindWinner(machine.GetFingerprint());
+        if (known) {
+            return engines_[*known]->GetName();
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * Забыть всех победителей
+     */
+    void ClearRecordedWinners() {
+        std::lock_guard<std::mutex> lock(winners_mutex_);
+        winners_.clear();
+    }
+};
@@ -0,0 +1,373 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SAMPLING_PROFILER_USE_SIGPROF 1
+#include <csignal>
+#include <sys/time.h>
+#else
+#define SAMPLING_PROFILER_USE_SIGPROF 0
+#endif
+
+/**
+ * Числовой идентификатор состояния для профиля: целые и перечисления -
+ * само значение, остальные типы - std::hash
+ */
+template <typename State>
+uint64_t ProfileStateId(const State& state) {
+    if constexpr (std::is_integral<State>::value || std::is_enum<State>::value) {
+        return static_cast<uint64_t>(state);
+    } else {
+        return static_cast<uint64_t>(std::hash<State>{}(state));
+    }
+}
+
+/**
+ * Строка профиля: сколько выборок пришлось на состояние и где была головка
+ */
+struct StateProfileEntry {
+    uint64_t state_id = 0;
+    size_t samples = 0;
+    long long min_head = 0;
+    long long max_head = 0;
+    double mean_head = 0.0;
+};
+
+/**
+ * Профиль горячих состояний, собранный SamplingProfiler
+ */
+class StateProfile {
+private:
+    std::vector<StateProfileEntry> entries_;   // По убыванию числа выборок
+    size_t total_samples_ = 0;
+    size_t idle_samples_ = 0;
+    size_t skipped_samples_ = 0;
+    size_t dropped_samples_ = 0;
+
+    friend class SamplingProfiler;
+
+public:
+    const std::vector<StateProfileEntry>& GetEntries() const {
+        return entries_;
+    }
+
+    /**
+     * Выборки, попавшие в работающую машину
+     */
+    size_t GetTotalSamples() const {
+        return total_samples_;
+    }
+
+    /**
+     * Выборки в потоках, где машина не выполнялась
+     */
+    size_t GetIdleSamples() const {
+        return idle_samples_;
+    }
+
+    /**
+     * Выборки, пришедшиеся на обновление слота (отброшены)
+     */
+    size_t GetSkippedSamples() const {
+        return skipped_samples_;
+    }
+
+    /**
+     * Выборки, не поместившиеся в буфер
+     */
+    size_t GetDroppedSamples() const {
+        return dropped_samples_;
+    }
+
+    size_t GetSamples(uint64_t state_id) const {
+        for (const auto& entry : entries_) {
+            if (entry.state_id == state_id) return entry.samples;
+        }
+        return 0;
+    }
+
+    /**
+     * Вывести top самых горячих состояний
+     */
+    void Print(std::ostream& out, size_t top = 10) const {
+        out << "Выборок: " << total_samples_ << " (вне машин: " << idle_samples_
+            << ", пропущено: " << skipped_samples_ << ", не поместилось: " << dropped_samples_ << ")" << std::endl;
+        for (size_t i = 0; i < entries_.size() && i < top; ++i) {
+            const auto& entry = entries_[i];
+            out << "  " << std::setw(20) << entry.state_id
+                << std::setw(8) << std::fixed << std::setprecision(1)
+                << 100.0 * static_cast<double>(entry.samples) / static_cast<double>(total_samples_) << "%"
+                << "  головка [" << entry.min_head << ", " << entry.max_head
+                << "], в среднем " << entry.mean_head << std::defaultfloat << std::endl;
+        }
+    }
+};
+
+/**
+ * Выборочный профилировщик состояний машин по таймеру SIGPROF
+ * Машина публикует текущее состояние и позицию головки в слот своего потока
+ * (две relaxed-записи на шаг, только пока профилировщик включён; выключенный
+ * стоит одной relaxed-загрузки флага). По сигналу таймера процессорного
+ * времени обработчик читает слот прерванного потока и кладёт выборку в
+ * заранее выделенный буфер - без блокировок и выделения памяти. При сборке
+ * с -DTURING_NO_PROFILING публикация вырезается целиком
+ */
+class SamplingProfiler {
+public:
+    static constexpr size_t DEFAULT_MAX_SAMPLES = 1 << 16;
+
+private:
+    /**
+     * Слот потока; пишет только свой поток, читает обработчик сигнала в нём же
+     */
+    struct Slot {
+        std::atomic<uint32_t> depth{0};     // Сколько машин выполняется в потоке
+        std::atomic<uint32_t> writing{0};   // Слот обновляется
+        std::atomic<uint64_t> state{0};
+        std::atomic<long long> head{0};
+    };
+
+    struct Sample {
+        uint64_t state;
+        long long head;
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<long long>::is_always_lock_free &&
+                  std::atomic<size_t>::is_always_lock_free && std::atomic<bool>::is_always_lock_free,
+                  "Обработчику сигнала нужны неблокирующие атомики");
+
+    /**
+     * Слот инициализируется константой, так что доступ из обработчика
+     * сигнала не требует ленивой инициализации
+     */
+    static Slot& ThisThreadSlot() {
+        static thread_local Slot slot;
+        return slot;
+    }
+
+    std::atomic<bool> enabled_{false};    // Машины публикуют состояние
+    std::atomic<bool> sampling_{false};   // Обработчик пишет выборки
+    std::atomic<size_t> in_handler_{0};
+    std::vector<Sample> samples_;
+    std::atomic<size_t> next_sample_{0};
+    std::atomic<size_t> idle_samples_{0};
+    std::atomic<size_t> skipped_samples_{0};
+    std::mutex control_mutex_;
+#if SAMPLING_PROFILER_USE_SIGPROF
+    struct sigaction previous_action_ {};
+#endif
+
+    SamplingProfiler() = default;
+
+    static void HandleSignal(int) {
+        SamplingProfiler& profiler = Instance();
+        profiler.in_handler_.fetch_add(1);
+        Slot& slot = ThisThreadSlot();
+        if (profiler.sampling_.load()) {
+            if (slot.depth.load(std::memory_order_relaxed) == 0) {
+                profiler.idle_samples_.fetch_add(1, std::memory_order_relaxed);
+            } else if (slot.writing.load(std::memory_order_relaxed) != 0) {
+                profiler.skipped_samples_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                size_t index = profiler.next_sample_.fetch_add(1, std::memory_order_relaxed);
+                if (index < profiler.samples_.size()) {
+                    profiler.samples_[index] = {slot.state.load(std::memory_order_relaxed),
+                                                slot.head.load(std::memory_order_relaxed)};
+                }
+            }
+        }
+        profiler.in_handler_.fetch_sub(1);
+    }
+
+#if SAMPLING_PROFILER_USE_SIGPROF
+    static void SetTimer(long interval_us) {
+        itimerval timer{};
+        timer.it_interval.tv_sec = interval_us / 1000000;
+        timer.it_interval.tv_usec = interval_us % 1000000;
+        timer.it_value = timer.it_interval;
+        ::setitimer(ITIMER_PROF, &timer, nullptr);
+    }
+#endif
+
+public:
+    SamplingProfiler(const SamplingProfiler&) = delete;
+    SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+
+    static SamplingProfiler& Instance() {
+        static SamplingProfiler profiler;
+        return profiler;
+    }
+
+    /**
+     * Публикуют ли машины своё состояние (дёшево, вызывается на каждом шаге)
+     */
+    static bool IsEnabled() {
+#ifdef TURING_NO_PROFILING
+        return false;
+#else
+        return Instance().enabled_.load(std::memory_order_relaxed);
+#endif
+    }
+
+    /**
+     * Обновить слот текущего потока
+     */
+    static void Publish(uint64_t state_id, long long head) {
+        Slot& slot = ThisThreadSlot();
+        slot.writing.store(1, std::memory_order_relaxed);
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        slot.state.store(state_id, std::memory_order_relaxed);
+        slot.head.store(head, std::memory_order_relaxed);
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        slot.writing.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * Отметка о том, что в потоке выполняется (или закончила выполняться) машина
+     */
+    static void EnterMachine() {
+        Slot& slot = ThisThreadSlot();
+        slot.depth.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void LeaveMachine() {
+        Slot& slot = ThisThreadSlot();
+        slot.depth.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    bool IsRunning() const {
+        return sampling_.load();
+    }
+
+    /**
+     * Начать сбор выборок
+     * @param frequency_hz Частота выборок в секунду процессорного времени процесса
+     * @param max_samples Размер буфера выборок (лишние считаются отброшенными)
+     * @throws std::logic_error если профилировщик уже запущен
+     * @throws std::runtime_error если платформа не поддерживает SIGPROF
+     */
+    void Start(unsigned frequency_hz = 1000, size_t max_samples = DEFAULT_MAX_SAMPLES) {
+        std::lock_guard<std::mutex> lock(control_mutex_);
+        if (sampling_.load()) {
+            throw std::logic_error("Профилировщик уже запущен");
+        }
+        if (frequency_hz == 0 || frequency_hz > 1000000) {
+            throw std::invalid_argument("Частота выборок должна быть от 1 до 1000000 Гц");
+        }
+#if SAMPLING_PROFILER_USE_SIGPROF
+        samples_.assign(std::max<size_t>(1, max_samples), Sample{0, 0});
+        next_sample_.store(0);
+        idle_samples_.store(0);
+        skipped_samples_.store(0);
+
+        struct sigaction action {};
+        action.sa_handler = &SamplingProfiler::HandleSignal;
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        if (::sigaction(SIGPROF, &action, &previous_action_) != 0) {
+            throw std::runtime_error("Не удалось установить обработчик SIGPROF");
+        }
+
+        enabled_.store(true);
+        sampling_.store(true);
+        SetTimer(std::max(1L, 1000000L / static_cast<long>(frequency_hz)));
+#else
+        (void)max_samples;
+        throw std::runtime_error("Выборочное профилирование не поддерживается на этой платформе");
+#endif
+    }
+
+    /**
+     * Остановить сбор и свести выборки в профиль
+     */
+    StateProfile Stop() {
+        std::lock_guard<std::mutex> lock(control_mutex_);
+        StateProfile profile;
+        if (!sampling_.load()) {
+            return profile;
+        }
+#if SAMPLING_PROFILER_USE_SIGPROF
+        SetTimer(0);
+        enabled_.store(false);
+        sampling_.store(false);
+        while (in_handler_.load() != 0) {
+            std::this_thread::yield();   // Обработчик, начатый до остановки
+        }
+        ::sigaction(SIGPROF, &previous_action_, nullptr);
+#endif
+
+        size_t taken = next_sample_.load();
+        size_t stored = std::min(taken, samples_.size());
+        profile.total_samples_ = stored;
+        profile.dropped_samples_ = taken - stored;
+        profile.idle_samples_ = idle_samples_.load();
+        profile.skipped_samples_ = skipped_samples_.load();
+
+        std::unordered_map<uint64_t, size_t> index_of;
+        std::vector<long double> head_sums;
+        for (size_t i = 0; i < stored; ++i) {
+            const Sample& sample = samples_[i];
+            auto [it, inserted] = index_of.emplace(sample.state, profile.entries_.size());
+            if (inserted) {
+                profile.entries_.push_back({sample.state, 0, sample.head, sample.head, 0.0});
+                head_sums.push_back(0);
+            }
+            StateProfileEntry& entry = profile.entries_[it->second];
+            entry.samples++;
+            entry.min_head = std::min(entry.min_head, sample.head);
+            entry.max_head = std::max(entry.max_head, sample.head);
+            head_sums[it->second] += sample.head;
+        }
+        for (size_t i = 0; i < profile.entries_.size(); ++i) {
+            profile.entries_[i].mean_head =
+                static_cast<double>(head_sums[i] / static_cast<long double>(profile.entries_[i].samples));
+        }
+        std::sort(profile.entries_.begin(), profile.entries_.end(),
+                  [](const StateProfileEntry& a, const StateProfileEntry& b) {
+                      return a.samples != b.samples ? a.samples > b.samples : a.state_id < b.state_id;
+                  });
+
+        samples_.clear();
+        samples_.shrink_to_fit();
+        return profile;
+    }
+};
+
+/**
+ * Область выполнения машины для профилировщика: пока объект жив, выборки
+ * в этом потоке относятся к машине
+ */
+class ProfiledRegion {
+private:
+    bool active_;
+
+public:
+    ProfiledRegion(uint64_t state_id, long long head) : active_(SamplingProfiler::IsEnabled()) {
+        if (active_) {
+            SamplingProfiler::Publish(state_id, head);
+            SamplingProfiler::EnterMachine();
+        }
+    }
+
+    ~ProfiledRegion() {
+        if (active_) {
+            SamplingProfiler::LeaveMachine();
+        }
+    }
+
+    ProfiledRegion(const ProfiledRegion&) = delete;
+    ProfiledRegion& operator=(const ProfiledRegion&) = delete;
+};
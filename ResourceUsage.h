@@ -0,0 +1,148 @@
+#pragma once
+
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define RESOURCE_USAGE_USE_THREAD_CLOCK 1
+#include <time.h>
+#else
+#define RESOURCE_USAGE_USE_THREAD_CLOCK 0
+#endif
+
+/**
+ * Процессорное время текущего потока в наносекундах
+ * (CLOCK_THREAD_CPUTIME_ID; там, где его нет, - монотонное настенное время)
+ */
+inline int64_t ThreadCpuNanos() {
+#if RESOURCE_USAGE_USE_THREAD_CLOCK
+    timespec now;
+    if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) == 0) {
+        return static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+    }
+#endif
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Счётчики выделений памяти по потокам
+ * Считает замещённый operator new, который подключается определением
+ * TURING_ALLOCATION_COUNTER_IMPLEMENTATION перед включением этого заголовка
+ * ровно в одной единице трансляции программы. Без него счётчики равны нулю
+ */
+class AllocationCounter {
+private:
+    struct Counts {
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+    };
+
+    // Инициализируются константой: безопасно вызывать из operator new
+    static Counts& ThisThread() {
+        static thread_local Counts counts;
+        return counts;
+    }
+
+    static std::atomic<bool>& InstalledFlag() {
+        static std::atomic<bool> installed{false};
+        return installed;
+    }
+
+public:
+    static void Count(size_t bytes) {
+        Counts& counts = ThisThread();
+        counts.allocations++;
+        counts.bytes += bytes;
+    }
+
+    static void MarkInstalled() {
+        InstalledFlag().store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * Подключён ли подсчёт (замещён ли operator new)
+     */
+    static bool IsInstalled() {
+        return InstalledFlag().load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Выделений в текущем потоке с его начала
+     */
+    static uint64_t GetThreadAllocations() {
+        return ThisThread().allocations;
+    }
+
+    /**
+     * Запрошено байт в текущем потоке с его начала
+     */
+    static uint64_t GetThreadAllocatedBytes() {
+        return ThisThread().bytes;
+    }
+};
+
+#ifdef TURING_ALLOCATION_COUNTER_IMPLEMENTATION
+
+// Не встраиваются: иначе компилятор видит free() для памяти из operator new
+#if defined(__GNUC__)
+#define ALLOCATION_COUNTER_NOINLINE __attribute__((noinline))
+#else
+#define ALLOCATION_COUNTER_NOINLINE
+#endif
+
+namespace allocation_counter_detail {
+
+inline void* Allocate(std::size_t size) {
+    AllocationCounter::Count(size);
+    return std::malloc(size ? size : 1);
+}
+
+struct Installer {
+    Installer() {
+        AllocationCounter::MarkInstalled();
+    }
+};
+
+static Installer installer;
+
+}  // namespace allocation_counter_detail
+
+ALLOCATION_COUNTER_NOINLINE void* operator new(std::size_t size) {
+    if (void* pointer = allocation_counter_detail::Allocate(size)) return pointer;
+    throw std::bad_alloc();
+}
+
+ALLOCATION_COUNTER_NOINLINE void* operator new[](std::size_t size) {
+    if (void* pointer = allocation_counter_detail::Allocate(size)) return pointer;
+    throw std::bad_alloc();
+}
+
+ALLOCATION_COUNTER_NOINLINE void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocation_counter_detail::Allocate(size);
+}
+
+ALLOCATION_COUNTER_NOINLINE void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocation_counter_detail::Allocate(size);
+}
+
+ALLOCATION_COUNTER_NOINLINE void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+ALLOCATION_COUNTER_NOINLINE void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+ALLOCATION_COUNTER_NOINLINE void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+ALLOCATION_COUNTER_NOINLINE void operator delete[](void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+#endif
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "TransitionManager.h"
+#include "StateManager.h"
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+/**
+ * Статический анализ графа состояний машины
+ * Вершины - состояния, рёбра - правила (s, a) -> (t, ...). Граф сжимается
+ * в компоненты сильной связности (алгоритм Тарьяна), по конденсации за
+ * O(V + E) вычисляется для каждого состояния:
+ * - достижимо ли из него конечное состояние;
+ * - может ли машина из него остановиться: дойти до конечного состояния или
+ *   до состояния, у которого нет правила хотя бы для одного символа алфавита.
+ * Состояние, из которого остановка невозможна, - ловушка: машина в нём
+ * работает вечно, что бы ни было на ленте. Алфавит - символы правил, пустой
+ * символ и символы входа; лента не может получить других, потому что
+ * записываются только символы правил
+ */
+template <typename State, typename Symbol>
+class StateGraphAnalysis {
+public:
+    using Rule = TransitionRule<State, Symbol>;
+
+private:
+    std::unordered_map<State, size_t> index_of_;
+    std::vector<size_t> component_of_;          // Компонента каждого состояния
+    std::vector<bool> component_can_accept_;
+    std::vector<bool> component_can_halt_;
+    std::vector<bool> component_is_bottom_;     // Нет рёбер в другие компоненты
+    size_t components_count_ = 0;
+
+    size_t IndexOf(const State& state) {
+        auto [it, inserted] = index_of_.emplace(state, index_of_.size());
+        return it->second;
+    }
+
+    /**
+     * Компоненты сильной связности в обратном топологическом порядке
+     * (итеративный Тарьян: глубина рекурсии не зависит от числа состояний)
+     */
+    void FindComponents(const std::vector<std::vector<size_t>>& edges) {
+        const size_t UNVISITED = static_cast<size_t>(-1);
+        size_t n = edges.size();
+        std::vector<size_t> order(n, UNVISITED);
+        std::vector<size_t> low(n, 0);
+        std::vector<bool> on_stack(n, false);
+        std::vector<size_t> stack;
+        std::vector<std::pair<size_t, size_t>> calls;   // (вершина, следующее ребро)
+        component_of_.assign(n, 0);
+        size_t counter = 0;
+
+        for (size_t root = 0; root < n; ++root) {
+            if (order[root] != UNVISITED) continue;
+            calls.push_back({root, 0});
+            order[root] = low[root] = counter++;
+            stack.push_back(root);
+            on_stack[root] = true;
+
+            while (!calls.empty()) {
+                auto& [vertex, next_edge] = calls.back();
+                if (next_edge < edges[vertex].size()) {
+                    size_t target = edges[vertex][next_edge++];
+                    if (order[target] == UNVISITED) {
+                        order[target] = low[target] = counter++;
+                        stack.push_back(target);
+                        on_stack[target] = true;
+                        calls.push_back({target, 0});
+                    } else if (on_stack[target]) {
+                        low[vertex] = std::min(low[vertex], order[target]);
+                    }
+                    continue;
+                }
+
+                size_t finished = vertex;
+                calls.pop_back();
+                if (!calls.empty()) {
+                    size_t parent = calls.back().first;
+                    low[parent] = std::min(low[parent], low[finished]);
+                }
+                if (low[finished] == order[finished]) {
+                    size_t member;
+                    do {
+                        member = stack.back();
+                        stack.pop_back();
+                        on_stack[member] = false;
+                        component_of_[member] = components_count_;
+                    } while (member != finished);
+                    components_count_++;
+                }
+            }
+        }
+    }
+
+public:
+    /**
+     * @param rules Правила переходов
+     * @param final_states Конечные состояния
+     * @param symbols Символы, которые могут встретиться на ленте помимо
+     *                символов правил (пустой символ и символы входа)
+     */
+    StateGraphAnalysis(const std::vector<Rule>& rules,
+                       const std::vector<State>& final_states,
+                       const std::vector<Symbol>& symbols) {
+        std::unordered_set<Symbol> alphabet(symbols.begin(), symbols.end());
+        for (const auto& rule : rules) {
+            alphabet.insert(rule.read_symbol);
+            alphabet.insert(rule.write_symbol);
+            IndexOf(rule.from_state);
+            IndexOf(rule.to_state);
+        }
+        for (const auto& state : final_states) {
+            IndexOf(state);
+        }
+
+        size_t n = index_of_.size();
+        std::vector<std::vector<size_t>> edges(n);
+        std::vector<size_t> rules_count(n, 0);   // Правила различаются по (состояние, символ)
+        for (const auto& rule : rules) {
+            size_t from = index_of_[rule.from_state];
+            edges[from].push_back(index_of_[rule.to_state]);
+            rules_count[from]++;
+        }
+        FindComponents(edges);
+
+        // Компонента может принять / остановиться сама или через потомка;
+        // потомки в порядке Тарьяна имеют меньшие номера
+        component_can_accept_.assign(components_count_, false);
+        component_can_halt_.assign(components_count_, false);
+        component_is_bottom_.assign(components_count_, true);
+        for (const auto& state : final_states) {
+            size_t component = component_of_[index_of_[state]];
+            component_can_accept_[component] = true;
+            component_can_halt_[component] = true;
+        }
+        for (size_t v = 0; v < n; ++v) {
+            if (rules_count[v] < alphabet.size()) {
+                component_can_halt_[component_of_[v]] = true;   // Есть символ без правила
+            }
+        }
+
+        std::vector<std::vector<size_t>> members(components_count_);
+        for (size_t v = 0; v < n; ++v) {
+            members[component_of_[v]].push_back(v);
+        }
+        for (size_t component = 0; component < components_count_; ++component) {
+            for (size_t v : members[component]) {
+                for (size_t target : edges[v]) {
+                    size_t next = component_of_[target];
+                    if (next == component) continue;
+                    component_is_bottom_[component] = false;
+                    if (component_can_accept_[next]) component_can_accept_[component] = true;
+                    if (component_can_halt_[next]) component_can_halt_[component] = true;
+                }
+            }
+        }
+    }
+
+    /**
+     * Построить анализ по менеджерам машины
+     */
+    StateGraphAnalysis(const TransitionManager<State, Symbol>& transitions,
+                       const StateManager<State>& states,
+                       const std::vector<Symbol>& symbols)
+        : StateGraphAnalysis(transitions.GetAllRules(),
+                             std::vector<State>(states.GetFinalStates().begin(), states.GetFinalStates().end()),
+                             symbols) {}
+
+    /**
+     * Машина в этом состоянии никогда не остановится
+     * (для состояний вне правил - false: без правил машина останавливается)
+     */
+    bool IsTrap(const State& state) const {
+        auto it = index_of_.find(state);
+        return it != index_of_.end() && !component_can_halt_[component_of_[it->second]];
+    }
+
+    /**
+     * Есть ли среди состояний хотя бы одна ловушка
+     */
+    bool HasTraps() const {
+        return std::find(component_can_halt_.begin(), component_can_halt_.end(), false) != component_can_halt_.end();
+    }
+
+    /**
+     * Достижимо ли конечное состояние из state
+     */
+    bool CanReachFinal(const State& state) const {
+        auto it = index_of_.find(state);
+        return it != index_of_.end() && component_can_accept_[component_of_[it->second]];
+    }
+
+    /**
+     * Может ли машина остановиться (принять или отклонить), начав в state
+     */
+    bool CanHalt(const State& state) const {
+        return !IsTrap(state);
+    }
+
+    /**
+     * Номер компоненты сильной связности состояния
+     * @throws std::out_of_range для состояния вне правил и конечных состояний
+     */
+    size_t GetComponent(const State& state) const {
+        return component_of_[index_of_.at(state)];
+    }
+
+    /**
+     * Из компоненты нет переходов в другие компоненты
+     */
+    bool IsBottomComponent(size_t component) const {
+        return component_is_bottom_.at(component);
+    }
+
+    size_t GetComponentsCount() const {
+        return components_count_;
+    }
+
+    size_t GetStatesCount() const {
+        return index_of_.size();
+    }
+};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "MemoryFootprint.h"
+
 #include <unordered_set>
 
 /**
@@ -8,10 +10,13 @@
  */
 template <typename State>
 class StateManager {
+public:
+    using FinalStates = std::unordered_set<State, std::hash<State>, std::equal_to<State>, TrackingAllocator<State>>;
+    
 private:
     State initial_state_;
     State current_state_;
-    std::unordered_set<State> final_states_;
+    FinalStates final_states_;
     
 public:
     explicit StateManager(const State& initial_state)
@@ -98,10 +103,17 @@ public:
     /**
      * Получить все конечные состояния
      */
-    const std::unordered_set<State>& GetFinalStates() const {
+    const FinalStates& GetFinalStates() const {
         return final_states_;
     }
     
+    /**
+     * Байт, занятых множеством конечных состояний
+     */
+    size_t GetMemoryBytes() const {
+        return final_states_.get_allocator().GetAllocatedBytes();
+    }
+    
     /**
      * Проверить, есть ли конечные состояния
      */
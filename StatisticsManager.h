@@ -1,11 +1,31 @@
 #pragma once
 
+#include "ResourceUsage.h"
+
 #include <chrono>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
 #include <iostream>
 
+/**
+ * Точка временного ряда пропускной способности: итог одного окна шагов
+ */
+struct ThroughputSample {
+    size_t step = 0;                // Шагов выполнено к концу окна
+    double elapsed_seconds = 0.0;   // Время выполнения к концу окна (без пауз между Run/Resume)
+    double steps_per_second = 0.0;  // Скорость в этом окне
+    size_t memory_bytes = 0;        // Объём ленты к концу окна
+};
+
 /**
  * Менеджер статистики выполнения машины Тьюринга
  * Отвечает за сбор и предоставление статистической информации
+ * Кроме настенного времени учитывает ресурсы запуска: процессорное время
+ * потока, выделения памяти (если подключён AllocationCounter) и пиковый
+ * объём ленты. Как и время, ресурсы считаются заново при каждом Run/Resume
  */
 class StatisticsManager {
 private:
@@ -15,6 +35,45 @@ private:
     std::chrono::high_resolution_clock::time_point end_time_;
     bool execution_started_;
     bool execution_finished_;
+    int64_t cpu_start_ns_ = 0;
+    int64_t cpu_time_ns_ = 0;
+    uint64_t allocations_start_ = 0;
+    uint64_t allocated_bytes_start_ = 0;
+    uint64_t allocations_ = 0;
+    uint64_t allocated_bytes_ = 0;
+    size_t peak_memory_bytes_ = 0;
+    
+    // Временной ряд: окно закрывается, когда step_count_ доходит до next_sample_step_
+    size_t series_window_ = 0;   // 0 - ряд не ведётся
+    size_t next_sample_step_ = std::numeric_limits<size_t>::max();
+    std::vector<ThroughputSample> series_;   // Кольцевой буфер
+    size_t series_capacity_ = 0;
+    size_t series_next_ = 0;
+    size_t series_total_ = 0;
+    size_t window_start_step_ = 0;
+    std::chrono::high_resolution_clock::time_point window_start_time_;
+    double finished_seconds_ = 0.0;   // Время завершённых Run/Resume
+    
+    void StartResourceAccounting() {
+        cpu_start_ns_ = ThreadCpuNanos();
+        allocations_start_ = AllocationCounter::GetThreadAllocations();
+        allocated_bytes_start_ = AllocationCounter::GetThreadAllocatedBytes();
+    }
+    
+    void StartWindow() {
+        window_start_step_ = step_count_;
+        window_start_time_ = start_time_;
+        next_sample_step_ = series_window_ > 0
+            ? (step_count_ / series_window_ + 1) * series_window_
+            : std::numeric_limits<size_t>::max();
+    }
+    
+    void ClearSeries() {
+        series_.clear();
+        series_next_ = 0;
+        series_total_ = 0;
+        finished_seconds_ = 0.0;
+    }
     
 public:
     explicit StatisticsManager(size_t max_steps = 100000)
@@ -31,6 +90,29 @@ public:
         execution_started_ = true;
         execution_finished_ = false;
         step_count_ = 0;
+        peak_memory_bytes_ = 0;
+        StartResourceAccounting();
+        ClearSeries();
+        StartWindow();
+    }
+    
+    /**
+     * Продолжить выполнение после остановки по лимиту
+     * Время измеряется заново, счётчик шагов сохраняется
+     */
+    void ResumeExecution() {
+        start_time_ = std::chrono::high_resolution_clock::now();
+        execution_started_ = true;
+        execution_finished_ = false;
+        StartResourceAccounting();
+        StartWindow();
+    }
+    
+    /**
+     * Установить счётчик шагов (при восстановлении из снимка)
+     */
+    void SetStepCount(size_t step_count) {
+        step_count_ = step_count;
     }
     
     /**
@@ -38,14 +120,117 @@ public:
      */
     void EndExecution() {
         end_time_ = std::chrono::high_resolution_clock::now();
+        cpu_time_ns_ = ThreadCpuNanos() - cpu_start_ns_;
+        allocations_ = AllocationCounter::GetThreadAllocations() - allocations_start_;
+        allocated_bytes_ = AllocationCounter::GetThreadAllocatedBytes() - allocated_bytes_start_;
+        if (!execution_finished_) {
+            finished_seconds_ += std::chrono::duration<double>(end_time_ - start_time_).count();
+        }
         execution_finished_ = true;
     }
     
+    /**
+     * Учесть текущий объём памяти (пик сохраняется)
+     * @param bytes Байт, занятых лентой и служебными структурами
+     */
+    void RecordMemoryUsage(size_t bytes) {
+        peak_memory_bytes_ = std::max(peak_memory_bytes_, bytes);
+    }
+    
     /**
      * Увеличить счётчик шагов
+     * @return true, если закрылось окно временного ряда и пора вызвать
+     *         RecordThroughputSample (проверка - одно сравнение на шаг)
+     */
+    bool IncrementStepCount() {
+        return ++step_count_ == next_sample_step_;
+    }
+    
+    /**
+     * Вести временной ряд пропускной способности
+     * @param window_steps Шагов в окне (0 - не вести ряд)
+     * @param capacity Сколько последних окон хранить
      */
-    void IncrementStepCount() {
-        step_count_++;
+    void EnableThroughputSeries(size_t window_steps, size_t capacity = 1024) {
+        series_window_ = window_steps;
+        series_capacity_ = std::max<size_t>(1, capacity);
+        ClearSeries();
+        series_.reserve(series_window_ > 0 ? series_capacity_ : 0);
+        next_sample_step_ = std::numeric_limits<size_t>::max();
+        if (series_window_ > 0 && execution_started_ && !execution_finished_) {
+            StartWindow();
+        }
+    }
+    
+    /**
+     * Закрыть текущее окно и записать точку ряда
+     * @param memory_bytes Текущий объём ленты
+     */
+    void RecordThroughputSample(size_t memory_bytes) {
+        auto now = std::chrono::high_resolution_clock::now();
+        double window_seconds = std::chrono::duration<double>(now - window_start_time_).count();
+        
+        ThroughputSample sample;
+        sample.step = step_count_;
+        sample.elapsed_seconds = finished_seconds_ + std::chrono::duration<double>(now - start_time_).count();
+        sample.steps_per_second = window_seconds > 0.0
+            ? static_cast<double>(step_count_ - window_start_step_) / window_seconds : 0.0;
+        sample.memory_bytes = memory_bytes;
+        RecordMemoryUsage(memory_bytes);
+        
+        if (series_.size() < series_capacity_) {
+            series_.push_back(sample);
+        } else {
+            series_[series_next_] = sample;   // Вытесняем самое старое окно
+        }
+        series_next_ = (series_next_ + 1) % series_capacity_;
+        series_total_++;
+        
+        window_start_step_ = step_count_;
+        window_start_time_ = now;
+        next_sample_step_ = step_count_ + series_window_;
+    }
+    
+    /**
+     * Точки ряда от старых к новым (не более capacity последних)
+     */
+    std::vector<ThroughputSample> GetThroughputSeries() const {
+        if (series_.size() < series_capacity_) {
+            return series_;
+        }
+        std::vector<ThroughputSample> ordered(series_.begin() + static_cast<std::ptrdiff_t>(series_next_), series_.end());
+        ordered.insert(ordered.end(), series_.begin(), series_.begin() + static_cast<std::ptrdiff_t>(series_next_));
+        return ordered;
+    }
+    
+    /**
+     * Сколько окон вытеснено из кольцевого буфера
+     */
+    size_t GetDroppedThroughputSamples() const {
+        return series_total_ - series_.size();
+    }
+    
+    size_t GetThroughputWindow() const {
+        return series_window_;
+    }
+    
+    /**
+     * Байт, занятых менеджером вместе с временным рядом
+     */
+    size_t GetMemoryBytes() const {
+        return sizeof(*this) + series_.capacity() * sizeof(ThroughputSample);
+    }
+    
+    /**
+     * Выгрузить ряд в CSV: шаг, время, шагов в секунду, байт ленты
+     */
+    void ExportThroughputCsv(std::ostream& out) const {
+        out << "step,elapsed_seconds,steps_per_second,memory_bytes" << std::endl;
+        for (const auto& sample : GetThroughputSeries()) {
+            out << sample.step << ',' << std::fixed << std::setprecision(6) << sample.elapsed_seconds << ','
+                << std::setprecision(1) << sample.steps_per_second << std::defaultfloat << ','
+                << sample.memory_bytes << std::endl;
+        }
     }
     
     /**
@@ -100,6 +285,40 @@ public:
         return std::chrono::duration_cast<std::chrono::microseconds>(end - start_time_);
     }
     
+    /**
+     * Процессорное время потока, выполнявшего машину, в микросекундах
+     * (в отличие от настенного времени не растёт, пока поток вытеснен)
+     */
+    std::chrono::microseconds GetCpuTimeMicros() const {
+        if (!execution_started_) {
+            return std::chrono::microseconds(0);
+        }
+        
+        int64_t nanos = execution_finished_ ? cpu_time_ns_ : ThreadCpuNanos() - cpu_start_ns_;
+        return std::chrono::microseconds(nanos / 1000);
+    }
+    
+    /**
+     * Выделений памяти за время выполнения (0, если подсчёт не подключён)
+     */
+    uint64_t GetAllocationsCount() const {
+        return allocations_;
+    }
+    
+    /**
+     * Байт, запрошенных за время выполнения (0, если подсчёт не подключён)
+     */
+    uint64_t GetAllocatedBytes() const {
+        return allocated_bytes_;
+    }
+    
+    /**
+     * Пиковый объём памяти с начала выполнения (байт)
+     */
+    size_t GetPeakMemoryBytes() const {
+        return peak_memory_bytes_;
+    }
+    
     /**
      * Получить среднее время на шаг в микросекундах
      */
@@ -117,6 +336,12 @@ public:
         step_count_ = 0;
         execution_started_ = false;
         execution_finished_ = false;
+        cpu_time_ns_ = 0;
+        allocations_ = 0;
+        allocated_bytes_ = 0;
+        peak_memory_bytes_ = 0;
+        ClearSeries();
+        next_sample_step_ = std::numeric_limits<size_t>::max();
     }
     
     /**
@@ -127,6 +352,11 @@ public:
         out << "Шагов выполнено: " << step_count_ << std::endl;
         out << "Максимально шагов: " << max_steps_ << std::endl;
         out << "Время выполнения: " << GetExecutionTime().count() << " мс" << std::endl;
+        out << "Процессорное время: " << GetCpuTimeMicros().count() << " мкс" << std::endl;
+        out << "Пиковая память: " << peak_memory_bytes_ << " байт" << std::endl;
+        if (AllocationCounter::IsInstalled()) {
+            out << "Выделений памяти: " << allocations_ << " (" << allocated_bytes_ << " байт)" << std::endl;
+        }
         
         if (step_count_ > 0) {
             out << "Среднее время на шаг: " << GetAverageTimePerStep() << " мкс" << std::endl;
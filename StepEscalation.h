@@ -0,0 +1,256 @@
+#pragma once
+
+#include "MT.h"
+#include "ExecutionEngines.h"
+#include "TapeCodec.h"
+
+#include <string>
+#include <vector>
+#include <limits>
+#include <fstream>
+#include <cstdio>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * Запись и чтение снимков машины в двоичном виде
+ * Поддерживаются тривиально копируемые типы и std::string;
+ * лента с целочисленными символами сжимается TapeCodec
+ */
+template <typename State, typename Symbol>
+class SnapshotSerializer {
+private:
+    template <typename T>
+    static std::enable_if_t<std::is_trivially_copyable_v<T>> WriteValue(std::ostream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    static void WriteValue(std::ostream& out, const std::string& value) {
+        WriteValue(out, value.size());
+        out.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    template <typename T>
+    static std::enable_if_t<std::is_trivially_copyable_v<T>> ReadValue(std::istream& in, T& value) {
+        in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    }
+
+    static void ReadValue(std::istream& in, std::string& value) {
+        size_t size = 0;
+        ReadValue(in, size);
+        value.resize(size);
+        in.read(value.data(), static_cast<std::streamsize>(size));
+    }
+
+public:
+    static void Write(std::ostream& out, const MachineSnapshot<State, Symbol>& snapshot) {
+        WriteValue(out, snapshot.state);
+        WriteValue(out, snapshot.head_position);
+        WriteValue(out, snapshot.step_count);
+        if constexpr (std::is_integral_v<Symbol>) {
+            auto encoded = TapeCodec<Symbol>::Encode(snapshot.tape_start, snapshot.tape);
+            WriteValue(out, encoded.size());
+            out.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+        } else {
+            WriteValue(out, snapshot.tape_start);
+            WriteValue(out, snapshot.tape.size());
+            for (const auto& symbol : snapshot.tape) {
+                WriteValue(out, symbol);
+            }
+        }
+    }
+
+    /**
+     * @throws std::runtime_error если поток повреждён
+     */
+    static MachineSnapshot<State, Symbol> Read(std::istream& in) {
+        MachineSnapshot<State, Symbol> snapshot;
+        size_t tape_size = 0;
+        ReadValue(in, snapshot.state);
+        ReadValue(in, snapshot.head_position);
+        ReadValue(in, snapshot.step_count);
+        if constexpr (std::is_integral_v<Symbol>) {
+            ReadValue(in, tape_size);
+            if (!in) {
+                throw std::runtime_error("Повреждённый снимок машины");
+            }
+            std::vector<uint8_t> encoded(tape_size);
+            in.read(reinterpret_cast<char*>(encoded.data()), static_cast<std::streamsize>(tape_size));
+            if (!in) {
+                throw std::runtime_error("Повреждённый снимок машины");
+            }
+            auto image = TapeCodec<Symbol>::Decode(encoded);
+            snapshot.tape_start = image.start;
+            snapshot.tape = std::move(image.cells);
+        } else {
+            ReadValue(in, snapshot.tape_start);
+            ReadValue(in, tape_size);
+            if (!in) {
+                throw std::runtime_error("Повреждённый снимок машины");
+            }
+            snapshot.tape.resize(tape_size);
+            for (auto& symbol : snapshot.tape) {
+                ReadValue(in, symbol);
+            }
+            if (!in) {
+                throw std::runtime_error("Повреждённый снимок машины");
+            }
+        }
+        return snapshot;
+    }
+};
+
+/**
+ * Задание для эскалации: машина и её вход
+ */
+template <typename State, typename Symbol>
+struct EscalationJob {
+    MachineDefinition<State, Symbol> machine;
+    std::vector<Symbol> input;
+};
+
+/**
+ * Итог эскалации для одного задания
+ */
+struct EscalationResult {
+    ExecutionResult result = ExecutionResult::ERROR;
+    size_t steps = 0;          // Итоговая длина выполнения
+    size_t rounds = 0;         // В скольких раундах участвовало задание
+    size_t final_budget = 0;   // Лимит шагов последнего раунда
+};
+
+/**
+ * Сводная статистика эскалации
+ */
+struct EscalationStatistics {
+    size_t rounds = 0;
+    size_t steps_executed = 0;        // Реально выполнено шагов (с продолжением)
+    size_t steps_if_restarted = 0;    // Столько шагов стоил бы перезапуск с нуля в каждом раунде
+    size_t snapshots_spilled = 0;     // Сколько снимков выгружено на диск
+    size_t peak_snapshot_bytes = 0;   // Пиковый объём снимков в памяти
+};
+
+/**
+ * Эскалация лимита шагов с продолжением
+ * Ответственность: раунды с удваивающимся лимитом, где задания с TIMEOUT
+ * продолжаются со снимка конфигурации, а не с нулевого шага. При нехватке
+ * памяти снимки выгружаются на диск
+ */
+template <typename State, typename Symbol>
+class StepEscalator {
+private:
+    size_t initial_budget_;
+    size_t max_budget_;
+    size_t memory_limit_bytes_;
+    std::string spill_directory_;
+    EscalationStatistics statistics_;
+
+    // Снимок задания: в памяти или в файле
+    struct PendingSnapshot {
+        std::optional<MachineSnapshot<State, Symbol>> in_memory;
+        std::string spill_path;
+    };
+
+    std::string SpillPath(size_t job_index) const {
+        return spill_directory_ + "/escalation_snapshot_" + std::to_string(job_index) + ".bin";
+    }
+
+public:
+    /**
+     * @param initial_budget Лимит шагов первого раунда
+     * @param max_budget Максимальный лимит (последний раунд)
+     * @param memory_limit_bytes Объём снимков в памяти, после которого они пишутся на диск
+     * @param spill_directory Каталог для снимков (пусто - не выгружать)
+     */
+    StepEscalator(size_t initial_budget, size_t max_budget,
+                  size_t memory_limit_bytes = std::numeric_limits<size_t>::max(),
+                  const std::string& spill_directory = "")
+        : initial_budget_(std::max<size_t>(1, initial_budget)),
+          max_budget_(std::max(initial_budget, max_budget)),
+          memory_limit_bytes_(memory_limit_bytes),
+          spill_directory_(spill_directory) {}
+
+    /**
+     * Выполнить задания с эскалацией лимита
+     * @return Результаты в порядке заданий
+     */
+    std::vector<EscalationResult> Run(const std::vector<EscalationJob<State, Symbol>>& jobs) {
+        statistics_ = EscalationStatistics{};
+        std::vector<EscalationResult> results(jobs.size());
+        std::vector<PendingSnapshot> snapshots(jobs.size());
+        std::vector<size_t> pending(jobs.size());
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            pending[i] = i;
+        }
+
+        size_t budget = initial_budget_;
+        size_t memory_used = 0;
+
+        while (!pending.empty()) {
+            statistics_.rounds++;
+            bool last_round = (budget >= max_budget_);
+            std::vector<size_t> still_pending;
+
+            for (size_t index : pending) {
+                auto machine = jobs[index].machine.Instantiate(jobs[index].input);
+                auto& stored = snapshots[index];
+                size_t resumed_from = 0;
+
+                if (stored.in_memory) {
+                    memory_used -= stored.in_memory->GetMemoryFootprint();
+                    machine->RestoreSnapshot(*stored.in_memory);
+                    stored.in_memory.reset();
+                } else if (!stored.spill_path.empty()) {
+                    std::ifstream in(stored.spill_path, std::ios::binary);
+                    machine->RestoreSnapshot(SnapshotSerializer<State, Symbol>::Read(in));
+                    in.close();
+                    std::remove(stored.spill_path.c_str());
+                    stored.spill_path.clear();
+                }
+                resumed_from = machine->GetStepCount();
+
+                ExecutionResult result = machine->Resume(budget);
+                size_t steps = machine->GetStepCount();
+                statistics_.steps_executed += steps - resumed_from;
+                statistics_.steps_if_restarted += steps;
+
+                auto& job_result = results[index];
+                job_result.result = result;
+                job_result.steps = steps;
+                job_result.rounds++;
+                job_result.final_budget = budget;
+
+                if (result != ExecutionResult::TIMEOUT || last_round) {
+                    continue;
+                }
+
+                auto snapshot = machine->CreateSnapshot();
+                size_t bytes = snapshot.GetMemoryFootprint();
+                if (!spill_directory_.empty() && memory_used + bytes > memory_limit_bytes_) {
+                    stored.spill_path = SpillPath(index);
+                    std::ofstream out(stored.spill_path, std::ios::binary | std::ios::trunc);
+                    SnapshotSerializer<State, Symbol>::Write(out, snapshot);
+                    if (!out) {
+                        throw std::runtime_error("Не удалось записать снимок: " + stored.spill_path);
+                    }
+                    statistics_.snapshots_spilled++;
+                } else {
+                    memory_used += bytes;
+                    statistics_.peak_snapshot_bytes = std::max(statistics_.peak_snapshot_bytes, memory_used);
+                    stored.in_memory = std::move(snapshot);
+                }
+                still_pending.push_back(index);
+            }
+
+            pending = std::move(still_pending);
+            budget = (budget > max_budget_ / 2) ? max_budget_ : budget * 2;
+        }
+
+        return results;
+    }
+
+    const EscalationStatistics& GetStatistics() const {
+        return statistics_;
+    }
+};
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * Отрезок ленты: ячейки [start, start + cells.size())
+ */
+template <typename Symbol>
+struct TapeImage {
+    int start = 0;
+    std::vector<Symbol> cells;
+};
+
+/**
+ * Компактное кодирование ленты
+ * Формат: версия, режим, границы (zigzag varint), словарь символов,
+ * затем либо RLE (индекс в словаре + длина серии, varint), либо
+ * упаковка индексов по 1/2/4/8 бит - выбирается меньший вариант.
+ * Поиск конца серии ускорен SSE2 для 1- и 4-байтовых символов
+ */
+template <typename Symbol>
+class TapeCodec {
+    static_assert(std::is_integral_v<Symbol>, "TapeCodec поддерживает только целочисленные символы");
+
+private:
+    static constexpr uint8_t FORMAT_VERSION = 1;
+    static constexpr uint8_t MODE_RLE = 0;
+    static constexpr uint8_t MODE_PACKED = 1;
+    static constexpr size_t MAX_PACKED_ALPHABET = 256;
+
+    static void WriteVarint(std::vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static void WriteSigned(std::vector<uint8_t>& out, int64_t value) {
+        WriteVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    /**
+     * Курсор чтения с проверкой границ
+     */
+    struct Reader {
+        const uint8_t* data;
+        size_t size;
+        size_t offset = 0;
+
+        uint8_t Byte() {
+            if (offset >= size) {
+                throw std::runtime_error("Закодированная лента обрезана");
+            }
+            return data[offset++];
+        }
+
+        uint64_t Varint() {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                uint8_t byte = Byte();
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return value;
+            }
+            throw std::runtime_error("Повреждённый varint в закодированной ленте");
+        }
+
+        int64_t Signed() {
+            uint64_t value = Varint();
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+    };
+
+    /**
+     * Конец серии одинаковых символов, начинающейся в begin
+     */
+    static size_t RunEnd(const Symbol* data, size_t begin, size_t end) {
+        const Symbol value = data[begin];
+        size_t i = begin + 1;
+#if defined(__SSE2__)
+        if constexpr (sizeof(Symbol) == 1) {
+            const __m128i pattern = _mm_set1_epi8(static_cast<char>(value));
+            while (i + 16 <= end) {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)));
+                if (mask != 0xFFFF) return i + static_cast<size_t>(__builtin_ctz(~mask));
+                i += 16;
+            }
+        } else if constexpr (sizeof(Symbol) == 4) {
+            const __m128i pattern = _mm_set1_epi32(static_cast<int>(value));
+            while (i + 4 <= end) {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi32(block, pattern)));
+                if (mask != 0xFFFF) return i + static_cast<size_t>(__builtin_ctz(~mask)) / 4;
+                i += 4;
+            }
+        }
+#endif
+        while (i < end && data[i] == value) ++i;
+        return i;
+    }
+
+    static unsigned BitsFor(size_t alphabet_size) {
+        if (alphabet_size <= 2) return 1;
+        if (alphabet_size <= 4) return 2;
+        if (alphabet_size <= 16) return 4;
+        return 8;
+    }
+
+public:
+    /**
+     * Закодировать отрезок ленты
+     * @param trim_blank Если задан, пустые ячейки по краям отбрасываются
+     */
+    static std::vector<uint8_t> Encode(int start, const std::vector<Symbol>& cells,
+                                       std::optional<Symbol> trim_blank = std::nullopt) {
+        size_t begin = 0;
+        size_t end = cells.size();
+        if (trim_blank && end > 0) {
+            if (cells[0] == *trim_blank) begin = RunEnd(cells.data(), 0, end);
+            while (end > begin && cells[end - 1] == *trim_blank) --end;
+        }
+        size_t length = end - begin;
+
+        // Серии и словарь
+        std::vector<std::pair<Symbol, size_t>> runs;
+        for (size_t i = begin; i < end;) {
+            size_t run_end = RunEnd(cells.data(), i, end);
+            runs.emplace_back(cells[i], run_end - i);
+            i = run_end;
+        }
+        std::vector<Symbol> alphabet;
+        for (const auto& run : runs) alphabet.push_back(run.first);
+        std::sort(alphabet.begin(), alphabet.end());
+        alphabet.erase(std::unique(alphabet.begin(), alphabet.end()), alphabet.end());
+
+        // Для однобайтовых символов индекс берётся из таблицы, иначе двоичным поиском
+        std::vector<uint16_t> byte_index;
+        if constexpr (sizeof(Symbol) == 1) {
+            byte_index.assign(256, 0);
+            for (size_t i = 0; i < alphabet.size(); ++i) {
+                byte_index[static_cast<uint8_t>(alphabet[i])] = static_cast<uint16_t>(i);
+            }
+        }
+        auto index_of = [&alphabet, &byte_index](Symbol symbol) -> size_t {
+            if constexpr (sizeof(Symbol) == 1) {
+                return byte_index[static_cast<uint8_t>(symbol)];
+            } else {
+                return static_cast<size_t>(std::lower_bound(alphabet.begin(), alphabet.end(), symbol) - alphabet.begin());
+            }
+        };
+
+        std::vector<uint8_t> out;
+        out.push_back(FORMAT_VERSION);
+        out.push_back(MODE_RLE);
+        WriteSigned(out, static_cast<int64_t>(start) + static_cast<int64_t>(begin));
+        WriteVarint(out, length);
+        WriteVarint(out, alphabet.size());
+        for (Symbol symbol : alphabet) {
+            WriteSigned(out, static_cast<int64_t>(symbol));
+        }
+        size_t header_size = out.size();
+
+        WriteVarint(out, runs.size());
+        for (const auto& [symbol, run_length] : runs) {
+            WriteVarint(out, index_of(symbol));
+            WriteVarint(out, run_length - 1);
+        }
+
+        // Упаковка выгоднее при коротких сериях и маленьком алфавите
+        if (alphabet.size() <= MAX_PACKED_ALPHABET) {
+            unsigned bits = BitsFor(alphabet.size());
+            size_t packed_size = 1 + (length * bits + 7) / 8;
+            if (packed_size < out.size() - header_size) {
+                out.resize(header_size);
+                out[1] = MODE_PACKED;
+                out.push_back(static_cast<uint8_t>(bits));
+                size_t base = out.size();
+                out.resize(base + (length * bits + 7) / 8, 0);
+                size_t bit = 0;
+                for (const auto& [symbol, run_length] : runs) {
+                    uint8_t index = static_cast<uint8_t>(index_of(symbol));
+                    for (size_t r = 0; r < run_length; ++r, bit += bits) {
+                        out[base + bit / 8] |= static_cast<uint8_t>(index << (bit % 8));
+                    }
+                }
+            }
+        }
+        return out;
+    }
+
+    static std::vector<uint8_t> Encode(const TapeImage<Symbol>& image,
+                                       std::optional<Symbol> trim_blank = std::nullopt) {
+        return Encode(image.start, image.cells, trim_blank);
+    }
+
+    /**
+     * Раскодировать ленту
+     * @throws std::runtime_error если данные повреждены
+     */
+    static TapeImage<Symbol> Decode(const uint8_t* data, size_t size) {
+        Reader reader{data, size};
+        if (reader.Byte() != FORMAT_VERSION) {
+            throw std::runtime_error("Неизвестная версия формата ленты");
+        }
+        uint8_t mode = reader.Byte();
+
+        TapeImage<Symbol> image;
+        image.start = static_cast<int>(reader.Signed());
+        size_t length = static_cast<size_t>(reader.Varint());
+        size_t alphabet_size = static_cast<size_t>(reader.Varint());
+        if (alphabet_size > size) {
+            throw std::runtime_error("Повреждённый словарь закодированной ленты");
+        }
+        std::vector<Symbol> alphabet(alphabet_size);
+        for (auto& symbol : alphabet) {
+            symbol = static_cast<Symbol>(reader.Signed());
+        }
+
+        if (mode == MODE_RLE) {
+            size_t runs = static_cast<size_t>(reader.Varint());
+            image.cells.reserve(std::min(length, size * 128));
+            for (size_t r = 0; r < runs; ++r) {
+                size_t index = static_cast<size_t>(reader.Varint());
+                size_t run_length = static_cast<size_t>(reader.Varint()) + 1;
+                if (index >= alphabet_size || run_length > length - image.cells.size()) {
+                    throw std::runtime_error("Повреждённая серия в закодированной ленте");
+                }
+                image.cells.insert(image.cells.end(), run_length, alphabet[index]);
+            }
+        } else if (mode == MODE_PACKED) {
+            unsigned bits = reader.Byte();
+            if (bits != 1 && bits != 2 && bits != 4 && bits != 8) {
+                throw std::runtime_error("Неверная ширина упаковки ленты");
+            }
+            size_t packed_size = (length * bits + 7) / 8;
+            if (length > size * 8 || packed_size > size - reader.offset) {
+                throw std::runtime_error("Закодированная лента обрезана");
+            }
+            const uint8_t* packed = data + reader.offset;
+            reader.offset += packed_size;
+            unsigned mask = (1u << bits) - 1;
+            image.cells.resize(length);
+            for (size_t i = 0, bit = 0; i < length; ++i, bit += bits) {
+                size_t index = (packed[bit / 8] >> (bit % 8)) & mask;
+                if (index >= alphabet_size) {
+                    throw std::runtime_error("Повреждённый индекс в закодированной ленте");
+                }
+                image.cells[i] = alphabet[index];
+            }
+        } else {
+            throw std::runtime_error("Неизвестный режим кодирования ленты");
+        }
+
+        if (image.cells.size() != length) {
+            throw std::runtime_error("Длина раскодированной ленты не совпадает с заголовком");
+        }
+        return image;
+    }
+
+    static TapeImage<Symbol> Decode(const std::vector<uint8_t>& encoded) {
+        return Decode(encoded.data(), encoded.size());
+    }
+
+    /**
+     * Закодировать использованный отрезок ленты машины без пустых краёв
+     */
+    template <typename Machine>
+    static std::vector<uint8_t> EncodeMachineTape(const Machine& machine) {
+        auto [first, last] = machine.GetStrip().GetUsedRange();
+        std::vector<Symbol> cells;
+        if (first <= last) {
+            cells = machine.GetStrip().GetSegment(first, static_cast<size_t>(last - first + 1));
+        }
+        return Encode(first <= last ? first : 0, cells, machine.GetBlankSymbol());
+    }
+};
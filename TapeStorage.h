@@ -0,0 +1,502 @@
+#pragma once
+
+#include "LazySeq.h"
+#include "Gen.h"
+#include "Mem.h"
+#include "MemoryFootprint.h"
+
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+/**
+ * Хранилища ленты для TuringStrip
+ * Каждое хранилище реализует: Get, Set, Reset, ReadSegment, GetUsedRange,
+ * GetStoredCellsCount, GetBlankSymbol, SetBlankSymbol.
+ * ReadSegment не меняет хранилище и допускает одновременные вызовы из
+ * нескольких потоков (после PrepareConcurrentReads(), если оно есть)
+ */
+
+/**
+ * Признак хранилища, которому нужна подготовка к одновременному чтению
+ */
+template <typename Storage, typename = void>
+struct HasConcurrentReadPreparation : std::false_type {};
+
+template <typename Storage>
+struct HasConcurrentReadPreparation<Storage, std::void_t<
+    decltype(std::declval<const Storage&>().PrepareConcurrentReads())>> : std::true_type {};
+
+/**
+ * Хранилище на основе LazySeq с картой записанных ячеек (по умолчанию)
+ * Вход лежит в ленивой последовательности, записи - в unordered_map
+ */
+template <typename Symbol>
+class LazyMapTapeStorage {
+public:
+    using StripSequence = LazySeq<Symbol, TapeGenerator<Symbol, std::vector<Symbol>>, ArraySeqMem<Symbol>>;
+    using Modifications = std::unordered_map<int, Symbol, std::hash<int>, std::equal_to<int>,
+                                             TrackingAllocator<std::pair<const int, Symbol>>>;
+
+private:
+    mutable StripSequence strip_;
+    Symbol blank_symbol_;
+
+    // Кеш для модифицированных ячеек (оригинал LazySeq не поддерживает модификацию)
+    mutable Modifications modifications_;
+
+public:
+    explicit LazyMapTapeStorage(const Symbol& blank_symbol, const std::vector<Symbol>& initial_data = {})
+        : strip_(TapeGenerator<Symbol, std::vector<Symbol>>(initial_data, blank_symbol), ArraySeqMem<Symbol>()),
+          blank_symbol_(blank_symbol) {}
+
+    Symbol Get(int position) const {
+        // Сначала проверяем кеш модификаций
+        auto it = modifications_.find(position);
+        if (it != modifications_.end()) {
+            return it->second;
+        }
+
+        // Если позиция отрицательная, возвращаем пустой символ
+        if (position < 0) {
+            return blank_symbol_;
+        }
+
+        // Получаем из ленивой последовательности (константный Get не
+        // материализует пустой хвост после входных данных)
+        auto symbol_ref = std::as_const(strip_).Get(static_cast<size_t>(position));
+        if (symbol_ref) {
+            return symbol_ref->get();
+        }
+
+        return blank_symbol_;
+    }
+
+    void Set(int position, const Symbol& symbol) {
+        modifications_[position] = symbol;
+    }
+
+    /**
+     * Прочитать count ячеек начиная с first
+     */
+    void ReadSegment(int first, size_t count, Symbol* out) const {
+        long long end = static_cast<long long>(first) + static_cast<long long>(count);
+        size_t negative = first < 0 ? static_cast<size_t>(std::min<long long>(0, end) - first) : 0;
+        std::fill_n(out, negative, blank_symbol_);
+
+        size_t filled = negative;
+        if (filled < count) {
+            size_t begin = static_cast<size_t>(static_cast<long long>(first) + static_cast<long long>(filled));
+            for (auto span : std::as_const(strip_).Spans(begin, begin + (count - filled))) {
+                std::copy(span.begin(), span.end(), out + filled);
+                filled += span.size;
+            }
+            std::fill(out + filled, out + count, blank_symbol_);
+        }
+
+        if (!modifications_.empty()) {
+            for (size_t i = 0; i < count; ++i) {
+                auto it = modifications_.find(first + static_cast<int>(i));
+                if (it != modifications_.end()) {
+                    out[i] = it->second;
+                }
+            }
+        }
+    }
+
+    /**
+     * Материализовать вход заранее: после этого чтение не меняет LazySeq
+     */
+    void PrepareConcurrentReads() const {
+        strip_.MaterializeUpTo(strip_.ImplicitTailStart());
+    }
+
+    void Reset(const std::vector<Symbol>& new_initial_data) {
+        modifications_.clear();
+        strip_ = StripSequence(TapeGenerator<Symbol, std::vector<Symbol>>(new_initial_data, blank_symbol_),
+                             ArraySeqMem<Symbol>());
+    }
+
+    const Symbol& GetBlankSymbol() const {
+        return blank_symbol_;
+    }
+
+    void SetBlankSymbol(const Symbol& blank_symbol) {
+        blank_symbol_ = blank_symbol;
+    }
+
+    std::pair<int, int> GetUsedRange() const {
+        int first = 0;
+        int last = static_cast<int>(strip_.ImplicitTailStart()) - 1;
+        bool empty = (last < first);
+        for (const auto& [position, symbol] : modifications_) {
+            if (empty) {
+                first = last = position;
+                empty = false;
+            } else {
+                first = std::min(first, position);
+                last = std::max(last, position);
+            }
+        }
+        return {first, last};
+    }
+
+    size_t GetStoredCellsCount() const {
+        return strip_.MaterializedCount() + modifications_.size();
+    }
+
+    size_t GetMaterializedCount() const {
+        return strip_.MaterializedCount();
+    }
+
+    size_t GetImplicitBlankStart() const {
+        return strip_.ImplicitTailStart();
+    }
+
+    Modifications& GetModifications() {
+        return modifications_;
+    }
+
+    const Modifications& GetModifications() const {
+        return modifications_;
+    }
+
+    /**
+     * Память ленты: вход в генераторе, кеш LazySeq, карта записей
+     */
+    MemoryFootprint GetMemoryFootprint() const {
+        MemoryFootprint footprint;
+        footprint.tape_base = strip_.ImplicitTailStart() * sizeof(Symbol);
+        footprint.memo = strip_.GetMemoryBytes();
+        footprint.tape_overlay = modifications_.get_allocator().GetAllocatedBytes();
+        footprint.metadata = sizeof(*this);
+        return footprint;
+    }
+};
+
+/**
+ * Хранилище из блоков фиксированного размера
+ * Блок выделяется при первой записи в него; последний использованный
+ * блок кешируется, так что локальные обращения не ищут в таблице
+ */
+template <typename Symbol, int ChunkSize = 256>
+class ChunkedTapeStorage {
+    static_assert(ChunkSize > 0, "Размер блока должен быть положительным");
+
+private:
+    using ChunkTable = std::unordered_map<int, std::vector<Symbol>, std::hash<int>, std::equal_to<int>,
+                                          TrackingAllocator<std::pair<const int, std::vector<Symbol>>>>;
+
+    ChunkTable chunks_;
+    Symbol blank_symbol_;
+    int first_ = 0;
+    int last_ = -1;
+
+    // Последний использованный блок (узлы unordered_map не перемещаются при рехешировании)
+    mutable int cached_index_ = 0;
+    mutable std::vector<Symbol>* cached_chunk_ = nullptr;
+
+    std::vector<Symbol>* FindChunk(int index) const {
+        if (cached_chunk_ && cached_index_ == index) {
+            return cached_chunk_;
+        }
+        auto it = chunks_.find(index);
+        if (it == chunks_.end()) {
+            return nullptr;
+        }
+        cached_index_ = index;
+        cached_chunk_ = const_cast<std::vector<Symbol>*>(&it->second);
+        return cached_chunk_;
+    }
+
+public:
+    static constexpr int CHUNK_SIZE = ChunkSize;
+
+    /**
+     * Номер блока и смещение в нём (с округлением вниз для отрицательных позиций)
+     */
+    static int ChunkIndex(int position) {
+        return position >= 0 ? position / ChunkSize : -((-position - 1) / ChunkSize) - 1;
+    }
+
+    static int ChunkOffset(int position) {
+        return position - ChunkIndex(position) * ChunkSize;
+    }
+
+    explicit ChunkedTapeStorage(const Symbol& blank_symbol, const std::vector<Symbol>& initial_data = {})
+        : blank_symbol_(blank_symbol) {
+        Reset(initial_data);
+    }
+
+    // Кеш указывает в собственную таблицу, поэтому при копировании сбрасывается
+    ChunkedTapeStorage(const ChunkedTapeStorage& other)
+        : chunks_(other.chunks_), blank_symbol_(other.blank_symbol_),
+          first_(other.first_), last_(other.last_) {}
+
+    ChunkedTapeStorage& operator=(const ChunkedTapeStorage& other) {
+        if (this != &other) {
+            chunks_ = other.chunks_;
+            blank_symbol_ = other.blank_symbol_;
+            first_ = other.first_;
+            last_ = other.last_;
+            cached_chunk_ = nullptr;
+        }
+        return *this;
+    }
+
+    ChunkedTapeStorage(ChunkedTapeStorage&&) = default;
+    ChunkedTapeStorage& operator=(ChunkedTapeStorage&&) = default;
+
+    Symbol Get(int position) const {
+        const auto* chunk = FindChunk(ChunkIndex(position));
+        return chunk ? (*chunk)[ChunkOffset(position)] : blank_symbol_;
+    }
+
+    /**
+     * Прочитать count ячеек начиная с first (кеш блока не используется)
+     */
+    void ReadSegment(int first, size_t count, Symbol* out) const {
+        size_t done = 0;
+        while (done < count) {
+            int position = first + static_cast<int>(done);
+            size_t offset = static_cast<size_t>(ChunkOffset(position));
+            size_t piece = std::min(count - done, static_cast<size_t>(ChunkSize) - offset);
+            auto it = chunks_.find(ChunkIndex(position));
+            if (it != chunks_.end()) {
+                std::copy_n(it->second.begin() + static_cast<std::ptrdiff_t>(offset), piece, out + done);
+            } else {
+                std::fill_n(out + done, piece, blank_symbol_);
+            }
+            done += piece;
+        }
+    }
+
+    void Set(int position, const Symbol& symbol) {
+        int index = ChunkIndex(position);
+        auto* chunk = FindChunk(index);
+        if (!chunk) {
+            chunk = &chunks_.emplace(index, std::vector<Symbol>(ChunkSize, blank_symbol_)).first->second;
+            cached_index_ = index;
+            cached_chunk_ = chunk;
+        }
+        (*chunk)[ChunkOffset(position)] = symbol;
+
+        if (first_ > last_) {
+            first_ = last_ = position;
+        } else {
+            first_ = std::min(first_, position);
+            last_ = std::max(last_, position);
+        }
+    }
+
+    void Reset(const std::vector<Symbol>& new_initial_data) {
+        chunks_.clear();
+        cached_chunk_ = nullptr;
+        first_ = 0;
+        last_ = -1;
+        for (size_t i = 0; i < new_initial_data.size(); ++i) {
+            Set(static_cast<int>(i), new_initial_data[i]);
+        }
+    }
+
+    const Symbol& GetBlankSymbol() const {
+        return blank_symbol_;
+    }
+
+    void SetBlankSymbol(const Symbol& blank_symbol) {
+        blank_symbol_ = blank_symbol;
+    }
+
+    std::pair<int, int> GetUsedRange() const {
+        return {first_, last_};
+    }
+
+    size_t GetStoredCellsCount() const {
+        return chunks_.size() * ChunkSize;
+    }
+
+    size_t GetChunksCount() const {
+        return chunks_.size();
+    }
+
+    /**
+     * Память ленты: блоки ячеек и таблица блоков
+     */
+    MemoryFootprint GetMemoryFootprint() const {
+        MemoryFootprint footprint;
+        footprint.tape_overlay = chunks_.size() * ChunkSize * sizeof(Symbol)
+                               + chunks_.get_allocator().GetAllocatedBytes();
+        footprint.metadata = sizeof(*this);
+        return footprint;
+    }
+};
+
+/**
+ * Хранилище-буфер с разрывом (gap buffer) в позиции головки
+ * Один непрерывный массив: левая часть ленты лежит в начале, правая - в конце,
+ * между ними разрыв. Запись переносит разрыв к ячейке, поэтому при локальном
+ * движении головки каждая операция переносит O(1) ячеек; чтение не двигает разрыв.
+ * Массив растёт удвоением, так что расширение ленты амортизированно O(1).
+ * Ячейки между записанной и хранимым отрезком при дальнем прыжке заполняются пустыми
+ */
+template <typename Symbol>
+class GapBufferTapeStorage {
+private:
+    static constexpr size_t INITIAL_CAPACITY = 64;
+
+    std::vector<Symbol> buffer_;   // [0, left_size_) - левая часть, [capacity - right_size_, capacity) - правая
+    size_t left_size_ = 0;
+    size_t right_size_ = 0;
+    int gap_position_ = 0;         // Позиция первой ячейки правой части
+    Symbol blank_symbol_;
+
+    size_t Capacity() const {
+        return buffer_.size();
+    }
+
+    size_t RightStart() const {
+        return Capacity() - right_size_;
+    }
+
+    /**
+     * Гарантировать, что в разрыве есть место ещё для extra ячеек
+     */
+    void Reserve(size_t extra) {
+        size_t used = left_size_ + right_size_;
+        if (used + extra <= Capacity()) {
+            return;
+        }
+        size_t new_capacity = std::max({Capacity() * 2, used + extra, INITIAL_CAPACITY});
+        std::vector<Symbol> grown(new_capacity, blank_symbol_);
+        std::move(buffer_.begin(), buffer_.begin() + static_cast<std::ptrdiff_t>(left_size_), grown.begin());
+        std::move(buffer_.begin() + static_cast<std::ptrdiff_t>(RightStart()), buffer_.end(),
+                  grown.end() - static_cast<std::ptrdiff_t>(right_size_));
+        buffer_.swap(grown);
+    }
+
+    /**
+     * Перенести разрыв к позиции (ячейка position становится первой в правой части)
+     * При пустом разрыве перенос сдвигал бы отрезок сам на себя (нарушение
+     * предусловий std::move / std::move_backward), поэтому разрыв сначала расширяется
+     */
+    void MoveGapTo(int position) {
+        if (position != gap_position_) {
+            Reserve(1);
+        }
+        if (position > gap_position_) {
+            size_t distance = static_cast<size_t>(position - gap_position_);
+            size_t moved = std::min(distance, right_size_);
+            auto source = buffer_.begin() + static_cast<std::ptrdiff_t>(RightStart());
+            std::move(source, source + static_cast<std::ptrdiff_t>(moved),
+                      buffer_.begin() + static_cast<std::ptrdiff_t>(left_size_));
+            left_size_ += moved;
+            right_size_ -= moved;
+
+            // Правая часть кончилась раньше позиции: дополняем левую пустыми
+            size_t padding = distance - moved;
+            if (padding > 0) {
+                Reserve(padding);
+                std::fill_n(buffer_.begin() + static_cast<std::ptrdiff_t>(left_size_), padding, blank_symbol_);
+                left_size_ += padding;
+            }
+        } else if (position < gap_position_) {
+            size_t distance = static_cast<size_t>(gap_position_ - position);
+            size_t moved = std::min(distance, left_size_);
+            auto source_end = buffer_.begin() + static_cast<std::ptrdiff_t>(left_size_);
+            std::move_backward(source_end - static_cast<std::ptrdiff_t>(moved), source_end,
+                               buffer_.begin() + static_cast<std::ptrdiff_t>(RightStart()));
+            left_size_ -= moved;
+            right_size_ += moved;
+
+            size_t padding = distance - moved;
+            if (padding > 0) {
+                Reserve(padding);
+                std::fill_n(buffer_.begin() + static_cast<std::ptrdiff_t>(RightStart() - padding), padding, blank_symbol_);
+                right_size_ += padding;
+            }
+        }
+        gap_position_ = position;
+    }
+
+public:
+    explicit GapBufferTapeStorage(const Symbol& blank_symbol, const std::vector<Symbol>& initial_data = {})
+        : blank_symbol_(blank_symbol) {
+        Reset(initial_data);
+    }
+
+    Symbol Get(int position) const {
+        if (position < gap_position_) {
+            size_t offset = static_cast<size_t>(gap_position_ - position);
+            return offset <= left_size_ ? buffer_[left_size_ - offset] : blank_symbol_;
+        }
+        size_t offset = static_cast<size_t>(position - gap_position_);
+        return offset < right_size_ ? buffer_[RightStart() + offset] : blank_symbol_;
+    }
+
+    /**
+     * Прочитать count ячеек начиная с first
+     */
+    void ReadSegment(int first, size_t count, Symbol* out) const {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = Get(first + static_cast<int>(i));
+        }
+    }
+
+    void Set(int position, const Symbol& symbol) {
+        MoveGapTo(position);
+        if (right_size_ == 0) {
+            Reserve(1);
+            right_size_ = 1;
+        }
+        buffer_[RightStart()] = symbol;
+    }
+
+    void Reset(const std::vector<Symbol>& new_initial_data) {
+        buffer_.assign(std::max(INITIAL_CAPACITY, new_initial_data.size() * 2), blank_symbol_);
+        std::copy(new_initial_data.begin(), new_initial_data.end(),
+                  buffer_.end() - static_cast<std::ptrdiff_t>(new_initial_data.size()));
+        left_size_ = 0;
+        right_size_ = new_initial_data.size();
+        gap_position_ = 0;
+    }
+
+    const Symbol& GetBlankSymbol() const {
+        return blank_symbol_;
+    }
+
+    void SetBlankSymbol(const Symbol& blank_symbol) {
+        blank_symbol_ = blank_symbol;
+    }
+
+    std::pair<int, int> GetUsedRange() const {
+        if (left_size_ + right_size_ == 0) {
+            return {0, -1};
+        }
+        return {gap_position_ - static_cast<int>(left_size_),
+                gap_position_ + static_cast<int>(right_size_) - 1};
+    }
+
+    size_t GetStoredCellsCount() const {
+        return left_size_ + right_size_;
+    }
+
+    size_t GetCapacity() const {
+        return Capacity();
+    }
+
+    /**
+     * Память ленты: один массив, включая разрыв
+     */
+    MemoryFootprint GetMemoryFootprint() const {
+        MemoryFootprint footprint;
+        footprint.tape_base = buffer_.capacity() * sizeof(Symbol);
+        footprint.metadata = sizeof(*this);
+        return footprint;
+    }
+
+    int GetGapPosition() const {
+        return gap_position_;
+    }
+};
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+
+/**
+ * Событие трассировки: интервал [start, start + duration) в потоке
+ * Имя и категория - строковые литералы (хранится только указатель)
+ */
+struct TraceEvent {
+    const char* category = "";
+    const char* name = "";
+    int64_t start_ns = 0;
+    int64_t duration_ns = 0;
+    const char* arg_name = nullptr;   // Необязательный числовой аргумент
+    long long arg_value = 0;
+};
+
+/**
+ * Трассировщик интервалов с выгрузкой в формате Chrome trace events
+ * (chrome://tracing, Perfetto). У каждого потока свой буфер; пока
+ * трассировка выключена, интервал стоит одной relaxed-загрузки флага.
+ * При сборке с -DTURING_NO_TRACING трассировка вырезается целиком
+ */
+class Tracer {
+public:
+    static constexpr size_t MAX_EVENTS_PER_THREAD = 1 << 20;
+
+private:
+    struct ThreadBuffer {
+        std::mutex mutex;   // Почти всегда свободен: пишет только свой поток
+        std::vector<TraceEvent> events;
+        size_t dropped = 0;
+        uint32_t thread_id = 0;
+        std::string thread_name;
+    };
+
+    std::atomic<bool> enabled_{false};
+    std::chrono::steady_clock::time_point epoch_ = std::chrono::steady_clock::now();
+    mutable std::mutex buffers_mutex_;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;   // Переживают свои потоки
+
+    Tracer() = default;
+
+    ThreadBuffer& GetThreadBuffer() {
+        thread_local std::shared_ptr<ThreadBuffer> buffer;
+        if (!buffer) {
+            buffer = std::make_shared<ThreadBuffer>();
+            std::lock_guard<std::mutex> lock(buffers_mutex_);
+            buffer->thread_id = static_cast<uint32_t>(buffers_.size() + 1);
+            buffers_.push_back(buffer);
+        }
+        return *buffer;
+    }
+
+    static void WriteJsonString(std::ostream& out, const char* text) {
+        out << '"';
+        for (const char* c = text; *c; ++c) {
+            switch (*c) {
+                case '"': out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n"; break;
+                default:
+                    if (static_cast<unsigned char>(*c) < 0x20) {
+                        out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                            << static_cast<int>(*c) << std::dec << std::setfill(' ');
+                    } else {
+                        out << *c;
+                    }
+            }
+        }
+        out << '"';
+    }
+
+public:
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    static Tracer& Instance() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    /**
+     * Включена ли трассировка (дёшево, можно вызывать на горячем пути)
+     */
+    static bool IsEnabled() {
+#ifdef TURING_NO_TRACING
+        return false;
+#else
+        return Instance().enabled_.load(std::memory_order_relaxed);
+#endif
+    }
+
+    void Enable() {
+        enabled_.store(true, std::memory_order_relaxed);
+    }
+
+    void Disable() {
+        enabled_.store(false, std::memory_order_relaxed);
+    }
+
+    /**
+     * Наносекунды от создания трассировщика
+     */
+    int64_t NowNanos() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - epoch_).count();
+    }
+
+    /**
+     * Записать событие в буфер текущего потока
+     */
+    void Record(const TraceEvent& event) {
+        ThreadBuffer& buffer = GetThreadBuffer();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        if (buffer.events.size() >= MAX_EVENTS_PER_THREAD) {
+            buffer.dropped++;
+            return;
+        }
+        buffer.events.push_back(event);
+    }
+
+    /**
+     * Подписать текущий поток в трассе
+     */
+    void SetThreadName(const std::string& name) {
+        ThreadBuffer& buffer = GetThreadBuffer();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        buffer.thread_name = name;
+    }
+
+    /**
+     * Удалить накопленные события (буферы потоков сохраняются)
+     */
+    void Clear() {
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        for (const auto& buffer : buffers_) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            buffer->events.clear();
+            buffer->dropped = 0;
+        }
+    }
+
+    size_t GetEventsCount() const {
+        size_t count = 0;
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        for (const auto& buffer : buffers_) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            count += buffer->events.size();
+        }
+        return count;
+    }
+
+    /**
+     * Сколько событий отброшено из-за переполнения буферов
+     */
+    size_t GetDroppedCount() const {
+        size_t count = 0;
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        for (const auto& buffer : buffers_) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            count += buffer->dropped;
+        }
+        return count;
+    }
+
+    /**
+     * Выгрузить события в JSON формата Chrome trace events
+     */
+    void WriteChromeTrace(std::ostream& out) const {
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        auto separator = [&out, &first]() {
+            if (!first) out << ",";
+            out << "\n";
+            first = false;
+        };
+
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        for (const auto& buffer : buffers_) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            if (!buffer->thread_name.empty()) {
+                separator();
+                out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->thread_id
+                    << ",\"args\":{\"name\":";
+                WriteJsonString(out, buffer->thread_name.c_str());
+                out << "}}";
+            }
+            for (const auto& event : buffer->events) {
+                separator();
+                out << "{\"ph\":\"X\",\"cat\":";
+                WriteJsonString(out, event.category);
+                out << ",\"name\":";
+                WriteJsonString(out, event.name);
+                out << ",\"pid\":1,\"tid\":" << buffer->thread_id
+                    << ",\"ts\":" << event.start_ns / 1000 << '.' << std::setw(3) << std::setfill('0') << event.start_ns % 1000
+                    << ",\"dur\":" << event.duration_ns / 1000 << '.' << std::setw(3) << event.duration_ns % 1000
+                    << std::setfill(' ');
+                if (event.arg_name) {
+                    out << ",\"args\":{";
+                    WriteJsonString(out, event.arg_name);
+                    out << ":" << event.arg_value << "}";
+                }
+                out << "}";
+            }
+        }
+        out << "\n]}\n";
+    }
+
+    /**
+     * Выгрузить события в файл
+     * @throws std::runtime_error если файл не открывается
+     */
+    void WriteChromeTrace(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out) {
+            throw std::runtime_error("Не удалось открыть файл трассы: " + path);
+        }
+        WriteChromeTrace(out);
+    }
+};
+
+/**
+ * Интервал трассировки: от создания до разрушения объекта
+ */
+class TraceSpan {
+private:
+    TraceEvent event_;
+    bool active_;
+
+public:
+    TraceSpan(const char* category, const char* name) : active_(Tracer::IsEnabled()) {
+        if (active_) {
+            event_.category = category;
+            event_.name = name;
+            event_.start_ns = Tracer::Instance().NowNanos();
+        }
+    }
+
+    ~TraceSpan() {
+        if (active_) {
+            event_.duration_ns = Tracer::Instance().NowNanos() - event_.start_ns;
+            Tracer::Instance().Record(event_);
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    /**
+     * Приложить к интервалу числовой аргумент (например, число шагов)
+     */
+    void SetArg(const char* name, long long value) {
+        if (active_) {
+            event_.arg_name = name;
+            event_.arg_value = value;
+        }
+    }
+};
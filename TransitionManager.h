@@ -1,8 +1,11 @@
 #pragma once
 
+#include "MemoryFootprint.h"
+
 #include <unordered_map>
 #include <optional>
 #include <functional>
+#include <vector>
 
 /**
  * Направления движения головки машины Тьюринга
@@ -49,9 +52,8 @@ public:
     using RuleKey = std::pair<State, Symbol>;
     
 private:
-    std::unordered_map<RuleKey, Rule, std::hash<RuleKey>> rules_map_;
-    
     // Кастомный хеш-функционал для пары (State, Symbol)
+    // (std::hash для std::pair не определён)
     struct PairHasher {
         std::size_t operator()(const RuleKey& key) const {
             std::size_t h1 = std::hash<State>{}(key.first);
@@ -60,18 +62,30 @@ private:
         }
     };
     
-public:
-    TransitionManager() {
-        // Переинициализируем с кастомным хешером
-        rules_map_ = std::unordered_map<RuleKey, Rule, PairHasher>();
+    std::unordered_map<RuleKey, Rule, PairHasher, std::equal_to<RuleKey>,
+                       TrackingAllocator<std::pair<const RuleKey, Rule>>> rules_map_;
+    
+    // Альтернативные правила недетерминированной машины (помимо основного)
+    std::unordered_map<RuleKey, std::vector<Rule>, PairHasher, std::equal_to<RuleKey>,
+                       TrackingAllocator<std::pair<const RuleKey, std::vector<Rule>>>> alternatives_;
+    
+    static bool SameRule(const Rule& a, const Rule& b) {
+        return a.from_state == b.from_state && a.read_symbol == b.read_symbol && a.to_state == b.to_state &&
+               a.write_symbol == b.write_symbol && a.direction == b.direction;
     }
     
+public:
+    TransitionManager() = default;
+    
     /**
      * Добавить правило перехода
      */
     void AddRule(const Rule& rule) {
         RuleKey key = std::make_pair(rule.from_state, rule.read_symbol);
         rules_map_[key] = rule;
+        if (!alternatives_.empty()) {
+            alternatives_.erase(key);
+        }
     }
     
     void AddRule(const State& from_state, const Symbol& read_symbol,
@@ -81,6 +95,59 @@ public:
         AddRule(rule);
     }
     
+    /**
+     * Добавить правило как ещё один вариант перехода (недетерминированная машина)
+     * Первое правило для (состояние, символ) становится основным - его
+     * исполняют детерминированные Step/Run и движки; остальные видны через
+     * FindRules. Повторное добавление того же правила ничего не меняет,
+     * AddRule заменяет все варианты одним правилом
+     */
+    void AddNondeterministicRule(const Rule& rule) {
+        RuleKey key = std::make_pair(rule.from_state, rule.read_symbol);
+        auto it = rules_map_.find(key);
+        if (it == rules_map_.end()) {
+            rules_map_.emplace(key, rule);
+            return;
+        }
+        if (SameRule(it->second, rule)) return;
+        auto& alternatives = alternatives_[key];
+        for (const auto& alternative : alternatives) {
+            if (SameRule(alternative, rule)) return;
+        }
+        alternatives.push_back(rule);
+    }
+    
+    void AddNondeterministicRule(const State& from_state, const Symbol& read_symbol,
+                                 const State& to_state, const Symbol& write_symbol,
+                                 Direction direction) {
+        AddNondeterministicRule(Rule(from_state, read_symbol, to_state, write_symbol, direction));
+    }
+    
+    /**
+     * Все варианты перехода для состояния и символа (основной - первым)
+     */
+    std::vector<Rule> FindRules(const State& state, const Symbol& symbol) const {
+        std::vector<Rule> rules;
+        RuleKey key = std::make_pair(state, symbol);
+        auto it = rules_map_.find(key);
+        if (it == rules_map_.end()) {
+            return rules;
+        }
+        rules.push_back(it->second);
+        auto alternatives = alternatives_.find(key);
+        if (alternatives != alternatives_.end()) {
+            rules.insert(rules.end(), alternatives->second.begin(), alternatives->second.end());
+        }
+        return rules;
+    }
+    
+    /**
+     * Есть ли (состояние, символ) с несколькими вариантами перехода
+     */
+    bool IsDeterministic() const {
+        return alternatives_.empty();
+    }
+    
     /**
      * Найти правило для заданного состояния и символа
      */
@@ -106,12 +173,47 @@ public:
      */
     void Clear() {
         rules_map_.clear();
+        alternatives_.clear();
     }
     
     /**
-     * Получить количество правил
+     * Получить количество основных правил (по одному на состояние и символ)
      */
     size_t GetRulesCount() const {
         return rules_map_.size();
     }
-};
\ No newline at end of file
+    
+    /**
+     * Байт, занятых таблицей правил (узлы и корзины)
+     */
+    size_t GetMemoryBytes() const {
+        size_t bytes = rules_map_.get_allocator().GetAllocatedBytes() + alternatives_.get_allocator().GetAllocatedBytes();
+        for (const auto& [key, alternatives] : alternatives_) {
+            bytes += alternatives.capacity() * sizeof(Rule);
+        }
+        return bytes;
+    }
+    
+    /**
+     * Получить все основные правила (порядок не определён)
+     */
+    std::vector<Rule> GetAllRules() const {
+        std::vector<Rule> rules;
+        rules.reserve(rules_map_.size());
+        for (const auto& [key, rule] : rules_map_) {
+            rules.push_back(rule);
+        }
+        return rules;
+    }
+    
+    /**
+     * Получить все правила вместе с альтернативными вариантами
+     */
+    std::vector<Rule> GetAllChoices() const {
+        std::vector<Rule> rules = GetAllRules();
+        for (const auto& [key, alternatives] : alternatives_) {
+            rules.insert(rules.end(), alternatives.begin(), alternatives.end());
+        }
+        return rules;
+    }
+};
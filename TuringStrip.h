@@ -1,27 +1,24 @@
 #pragma once
 
-#include "LazySeq.h"
-#include "Gen.h"
-#include "Mem.h"
+#include "TapeStorage.h"
 
 #include <vector>
 #include <unordered_map>
+#include <utility>
+#include <algorithm>
 
 /**
  * Лента (полоса) машины Тьюринга на основе LazySequence
  * Ответственность: хранение, чтение и запись символов на бесконечной ленте
+ * @tparam Storage Хранилище ячеек (см. TapeStorage.h); по умолчанию LazySeq с картой записей
  */
-template <typename Symbol>
+template <typename Symbol, typename Storage = LazyMapTapeStorage<Symbol>>
 class TuringStrip {
 public:
-    using StripSequence = LazySeq<Symbol, TapeGenerator<Symbol, std::vector<Symbol>>, ArraySeqMem<Symbol>>;
+    using StorageType = Storage;
     
 private:
-    mutable StripSequence strip_;
-    Symbol blank_symbol_;
-    
-    // Кеш для модифицированных ячеек (оригинал LazySeq не поддерживает модификацию)
-    mutable std::unordered_map<int, Symbol> modifications_;
+    Storage storage_;
     
 public:
     /**
@@ -30,32 +27,14 @@ public:
      * @param initial_data Начальные данные на ленте
      */
     explicit TuringStrip(const Symbol& blank_symbol, const std::vector<Symbol>& initial_data = {})
-        : strip_(TapeGenerator<Symbol, std::vector<Symbol>>(initial_data, blank_symbol), ArraySeqMem<Symbol>()),
-          blank_symbol_(blank_symbol) {}
+        : storage_(blank_symbol, initial_data) {}
     
     /**
      * Получить символ по позиции
      * @param position Позиция на ленте (может быть отрицательной)
      */
     Symbol GetSymbolAt(int position) const {
-        // Сначала проверяем кеш модификаций
-        auto it = modifications_.find(position);
-        if (it != modifications_.end()) {
-            return it->second;
-        }
-        
-        // Если позиция отрицательная, возвращаем пустой символ
-        if (position < 0) {
-            return blank_symbol_;
-        }
-        
-        // Получаем из ленивой последовательности
-        auto symbol_ref = strip_.Get(static_cast<size_t>(position));
-        if (symbol_ref) {
-            return symbol_ref->get();
-        }
-        
-        return blank_symbol_;
+        return storage_.Get(position);
     }
     
     /**
@@ -64,8 +43,7 @@ public:
      * @param symbol Новый символ
      */
     void SetSymbolAt(int position, const Symbol& symbol) {
-        // Сохраняем модификацию в кеше
-        modifications_[position] = symbol;
+        storage_.Set(position, symbol);
     }
     
     /**
@@ -84,59 +62,119 @@ public:
         return segment;
     }
     
+    /**
+     * Прочитать count ячеек начиная с first в out
+     * Хранилище не меняется, поэтому после PrepareConcurrentReads()
+     * ленту можно читать из нескольких потоков одновременно
+     */
+    void ReadSegment(int first, size_t count, Symbol* out) const {
+        storage_.ReadSegment(first, count, out);
+    }
+    
+    /**
+     * Подготовить хранилище к одновременному чтению (если ему это нужно)
+     */
+    void PrepareConcurrentReads() const {
+        if constexpr (HasConcurrentReadPreparation<Storage>::value) {
+            storage_.PrepareConcurrentReads();
+        }
+    }
+    
     /**
      * Очистить ленту (сбросить модификации)
      */
     void Reset(const std::vector<Symbol>& new_initial_data = {}) {
-        modifications_.clear();
-        strip_ = StripSequence(TapeGenerator<Symbol, std::vector<Symbol>>(new_initial_data, blank_symbol_), 
-                             ArraySeqMem<Symbol>());
+        storage_.Reset(new_initial_data);
     }
     
     /**
      * Получить пустой символ
      */
     const Symbol& GetBlankSymbol() const {
-        return blank_symbol_;
+        return storage_.GetBlankSymbol();
     }
     
     /**
      * Установить новый пустой символ
      */
     void SetBlankSymbol(const Symbol& blank_symbol) {
-        blank_symbol_ = blank_symbol;
+        storage_.SetBlankSymbol(blank_symbol);
+    }
+    
+    /**
+     * Отрезок ленты, содержащий вход и все записанные ячейки
+     * @return Пара [first, last]; для пустой ленты без записей - [0, -1]
+     */
+    std::pair<int, int> GetUsedRange() const {
+        return storage_.GetUsedRange();
     }
     
+    /**
+     * Сколько ячеек хранится в памяти
+     */
+    size_t GetStoredCellsCount() const {
+        return storage_.GetStoredCellsCount();
+    }
+    
+    /**
+     * Разбивка памяти ленты (основа, записи, кеш, служебные данные)
+     */
+    MemoryFootprint GetMemoryFootprint() const {
+        MemoryFootprint footprint = storage_.GetMemoryFootprint();
+        footprint.metadata += sizeof(*this) - sizeof(Storage);
+        return footprint;
+    }
+    
+    /**
+     * Доступ к хранилищу (для специфичной для него статистики)
+     */
+    Storage& GetStorage() {
+        return storage_;
+    }
+    
+    const Storage& GetStorage() const {
+        return storage_;
+    }
+    
+    // Методы ниже доступны только для хранилища LazyMapTapeStorage
+    
     /**
      * Получить статистику о ленте
      */
     size_t GetMaterializedCount() const {
-        return strip_.MaterializedCount();
+        return storage_.GetMaterializedCount();
     }
     
     size_t GetModificationsCount() const {
-        return modifications_.size();
+        return storage_.GetModifications().size();
+    }
+    
+    /**
+     * Позиция, начиная с которой лента неявно пуста (конец входных данных)
+     */
+    size_t GetImplicitBlankStart() const {
+        return storage_.GetImplicitBlankStart();
     }
     
     /**
      * Проверить, есть ли модификации на ленте
      */
     bool HasModifications() const {
-        return !modifications_.empty();
+        return !storage_.GetModifications().empty();
     }
     
     /**
      * Получить все модификации (позиция -> символ)
      */
-    const std::unordered_map<int, Symbol>& GetModifications() const {
-        return modifications_;
+    const auto& GetModifications() const {
+        return storage_.GetModifications();
     }
     
     /**
      * Очистить только модификации (оставить основную ленту нетронутой)
      */
     void ClearModifications() {
-        modifications_.clear();
+        storage_.GetModifications().clear();
     }
     
     /**
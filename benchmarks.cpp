@@ -0,0 +1,446 @@
+#include "MT.h"
+#include "MachineEnumerator.h"
+#include "Deciders.h"
+#include "TapeCodec.h"
+#include "ChunkStore.h"
+#include "LazySeq.h"
+#include "ParallelReduce.h"
+#include "JitEngine.h"
+#include <thread>
+#include <memory>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <functional>
+#include <numeric>
+#include <filesystem>
+
+/**
+ * Бенчмарки
+ * - хранилища ленты: машины из examples.cpp на длинных входах и зигзаг,
+ *   прогнанные на LazyMapTapeStorage, ChunkedTapeStorage и GapBufferTapeStorage
+ * - кодирование лент TapeCodec на выходных лентах перечисленных машин
+ * - дедупликация блоков DedupTapeStorage на пакете машин с общим входом
+ * - полный проход LazySeq: поэлементный Get(i) против участков Spans()
+ * - параллельные свёртки ParallelReducer по ленте из 10^9 ячеек
+ * - тёплый старт LazySeq: загрузка сохранённого префикса против повторной генерации
+ * - JIT-компиляция в машинный код x86-64 против интерпретатора на машинах бенчмарка лент
+ */
+
+const int FINAL_STATE = -1;
+
+/**
+ * Описание бенчмарка: правила, вход и лимит шагов
+ */
+struct TapeBenchmark {
+    std::string name;
+    std::vector<char> input;
+    size_t max_steps;
+    std::function<void(std::function<void(int, char, int, char, Direction)>)> rules;
+};
+
+template <typename Storage>
+void RunTapeBenchmark(const TapeBenchmark& benchmark, const std::string& storage_name) {
+    TuringMachine<int, char, Storage> tm(0, '_', benchmark.input);
+    benchmark.rules([&tm](int from, char read, int to, char write, Direction direction) {
+        tm.AddTransition(from, read, to, write, direction);
+    });
+    tm.AddFinalState(FINAL_STATE);
+
+    auto start = std::chrono::steady_clock::now();
+    tm.Run(benchmark.max_steps);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::left << std::setw(20) << benchmark.name
+              << std::setw(10) << storage_name
+              << std::right << std::setw(12) << tm.GetStepCount()
+              << std::setw(10) << std::fixed << std::setprecision(3) << seconds
+              << std::setw(12) << std::setprecision(1) << static_cast<double>(tm.GetStepCount()) / seconds / 1e6
+              << std::setw(12) << tm.GetStrip().GetStoredCellsCount()
+              << std::defaultfloat << std::endl;
+}
+
+/**
+ * Корпус выходных лент: все канонические машины n x 2 после steps шагов
+ */
+std::vector<TapeImage<char>> BuildTapeCorpus(int states, size_t steps) {
+    std::vector<TapeImage<char>> corpus;
+    MachineEnumerator enumerator(states, 2);
+    enumerator.Enumerate([&](const MachineEnumerator::Table& table) {
+        CandidateMachine machine{corpus.size(), states, 2, table};
+        TableSimulator simulator(machine);
+        while (simulator.GetStepCount() < steps && simulator.Step()) {
+        }
+        TapeImage<char> image;
+        image.start = simulator.GetMinPosition();
+        for (int position = simulator.GetMinPosition(); position <= simulator.GetMaxPosition(); ++position) {
+            image.cells.push_back(static_cast<char>('0' + simulator.GetSymbolAt(position)));
+        }
+        corpus.push_back(std::move(image));
+    });
+    return corpus;
+}
+
+void RunTapeCodecBenchmark(int states, size_t steps) {
+    auto corpus = BuildTapeCorpus(states, steps);
+
+    size_t raw_bytes = 0;
+    for (const auto& image : corpus) raw_bytes += image.cells.size();
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::vector<uint8_t>> encoded;
+    encoded.reserve(corpus.size());
+    for (const auto& image : corpus) {
+        encoded.push_back(TapeCodec<char>::Encode(image, '0'));
+    }
+    double encode_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t encoded_bytes = 0;
+    for (const auto& bytes : encoded) encoded_bytes += bytes.size();
+
+    start = std::chrono::steady_clock::now();
+    size_t decoded_cells = 0;
+    for (const auto& bytes : encoded) {
+        decoded_cells += TapeCodec<char>::Decode(bytes).cells.size();
+    }
+    double decode_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Машины " << states << " x 2, " << steps << " шагов: лент " << corpus.size()
+              << ", сырых байт " << raw_bytes << ", закодировано " << encoded_bytes
+              << std::fixed << std::setprecision(2)
+              << " (в " << static_cast<double>(raw_bytes) / static_cast<double>(encoded_bytes) << " раз меньше)"
+              << std::setprecision(0)
+              << ", кодирование " << static_cast<double>(raw_bytes) / encode_seconds / 1e6 << " МБ/с"
+              << ", декодирование " << static_cast<double>(decoded_cells) / decode_seconds / 1e6 << " МБ/с"
+              << std::defaultfloat << std::endl;
+}
+
+/**
+ * Пакет машин с одинаковым входом: машина i инвертирует префикс длиной (i + 1) * prefix_step.
+ * Возвращает время пакета на threads потоках и общий объём лент в байтах
+ */
+template <typename Storage>
+std::pair<double, size_t> RunSharedInputBatch(size_t machines_count, size_t prefix_step,
+                                              const std::vector<char>& input, size_t threads_count,
+                                              std::vector<UniquePtr<TuringMachine<int, char, Storage>>>& machines) {
+    machines.clear();
+    for (size_t i = 0; i < machines_count; ++i) {
+        machines.push_back(MakeTuringMachine<int, char, Storage>(0, '_', input));
+        machines.back()->AddTransition(0, '0', 0, '1', Direction::RIGHT);
+        machines.back()->AddTransition(0, '1', 0, '0', Direction::RIGHT);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threads_count; ++t) {
+        threads.emplace_back([&, t]() {
+            for (size_t i = t; i < machines_count; i += threads_count) {
+                machines[i]->Run((i + 1) * prefix_step);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t bytes = 0;
+    for (const auto& machine : machines) {
+        bytes += machine->GetStrip().GetStoredCellsCount() * sizeof(char);
+    }
+    return {seconds, bytes};
+}
+
+void RunDedupBenchmark() {
+    const size_t MACHINES = 512;
+    const size_t PREFIX_STEP = 256;
+    const size_t THREADS = 4;
+    std::vector<char> input(1 << 16);
+    unsigned seed = 1;
+    for (auto& cell : input) {
+        seed = seed * 1103515245u + 12345u;
+        cell = ((seed >> 16) & 1) ? '1' : '0';
+    }
+
+    std::vector<UniquePtr<TuringMachine<int, char, ChunkedTapeStorage<char>>>> chunked;
+    auto [chunked_seconds, chunked_bytes] =
+        RunSharedInputBatch(MACHINES, PREFIX_STEP, input, THREADS, chunked);
+
+    auto store = ChunkStore<char>::GetDefault();
+    std::vector<UniquePtr<TuringMachine<int, char, DedupTapeStorage<char>>>> dedup;
+    auto [dedup_seconds, referenced_bytes] =
+        RunSharedInputBatch(MACHINES, PREFIX_STEP, input, THREADS, dedup);
+    size_t private_bytes = 0;
+    for (auto& machine : dedup) {
+        machine->GetStrip().GetStorage().Seal();
+        private_bytes += machine->GetStrip().GetStorage().GetPrivateBytes();
+    }
+    auto statistics = store->GetStatistics();
+
+    std::cout << "Машин: " << MACHINES << ", вход " << input.size() << " ячеек, потоков " << THREADS << std::endl;
+    std::cout << std::fixed << std::setprecision(3)
+              << "chunked: " << chunked_bytes / 1024 << " КБ лент, " << chunked_seconds << " с" << std::endl
+              << "dedup:   " << statistics.stored_bytes / 1024 << " КБ общих блоков + "
+              << private_bytes / 1024 << " КБ таблиц, " << dedup_seconds << " с" << std::endl
+              << std::setprecision(1)
+              << "Коэффициент дедупликации: " << static_cast<double>(referenced_bytes) / static_cast<double>(statistics.stored_bytes)
+              << ", попаданий при сдаче блоков: " << statistics.dedup_hits << " из " << statistics.intern_requests
+              << std::defaultfloat << std::endl;
+}
+
+/**
+ * Проход count элементов LazySeq: холодный (с генерацией) и повторный
+ */
+void RunLazySeqScanBenchmark(size_t count) {
+    using Seq = LazySeq<long long, FunctionGenerator<long long>, ArraySeqMem<long long>>;
+    auto make_seq = []() {
+        long long next = 0;
+        return Seq(FunctionGenerator<long long>([next]() mutable { return next++ * 3 % 1000; }),
+                   ArraySeqMem<long long>());
+    };
+
+    auto scan_get = [count](const Seq& seq) {
+        long long sum = 0;
+        for (size_t i = 0; i < count; ++i) {
+            sum += seq.Get(i)->get();
+        }
+        return sum;
+    };
+    auto scan_spans = [count](const Seq& seq) {
+        long long sum = 0;
+        for (auto span : seq.Spans(0, count)) {
+            sum = std::accumulate(span.begin(), span.end(), sum);
+        }
+        return sum;
+    };
+
+    auto measure = [](const std::string& name, const Seq& seq, auto scan) {
+        auto start = std::chrono::steady_clock::now();
+        long long sum = scan(seq);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        // Название в конце строки: setw считает байты, а не символы
+        std::cout << std::fixed << std::setprecision(3) << std::setw(8) << seconds
+                  << std::setprecision(0) << std::setw(10) << static_cast<double>(seq.MaterializedCount()) / seconds / 1e6
+                  << "   " << name << " (сумма " << sum << ")" << std::defaultfloat << std::endl;
+    };
+
+    std::cout << "Элементов: " << count << std::endl << "     сек  Мэлем/с   проход" << std::endl;
+    const Seq by_get = make_seq();
+    measure("Get(i), холодный", by_get, scan_get);
+    measure("Get(i), повторный", by_get, scan_get);
+    const Seq by_spans = make_seq();
+    measure("Spans(), холодный", by_spans, scan_spans);
+    measure("Spans(), повторный", by_spans, scan_spans);
+}
+
+/**
+ * Аналитика по ленте из cells ячеек: последовательный GetSymbolAt против ParallelReducer
+ */
+void RunParallelReduceBenchmark(int cells) {
+    // Редкие записи по всей длине и плотный участок в начале
+    TuringStrip<char, ChunkedTapeStorage<char>> strip('_');
+    for (int position = 0; position < cells; position += 4099) {
+        strip.SetSymbolAt(position, '1');
+    }
+    for (int position = 0; position < (1 << 24); ++position) {
+        strip.SetSymbolAt(position, (position % 7 == 0) ? '1' : '0');
+    }
+    strip.SetSymbolAt(cells - 1, '0');
+    std::cout << "Ячеек: " << cells << ", хранится " << strip.GetStoredCellsCount() << std::endl;
+
+    auto timed = [](const std::string& name, auto body) {
+        auto start = std::chrono::steady_clock::now();
+        auto result = body();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << std::fixed << std::setprecision(3) << std::setw(8) << seconds << std::defaultfloat
+                  << "   " << name << " = " << result << std::endl;
+    };
+
+    std::cout << "     сек   операция" << std::endl;
+    timed("последовательно: число '1'", [&]() {
+        size_t count = 0;
+        for (int position = 0; position < cells; ++position) {
+            count += strip.GetSymbolAt(position) == '1';
+        }
+        return count;
+    });
+
+    ParallelReducer reducer;
+    std::string threads = std::to_string(reducer.GetThreadsCount()) + " пот.";
+    timed("параллельно (" + threads + "): число '1'", [&]() {
+        return reducer.Count(strip, 0, cells - 1, '1');
+    });
+    timed("параллельно (" + threads + "): последняя непустая", [&]() {
+        return *reducer.FindLast(strip, 0, cells - 1, [](char c) { return c != '_'; });
+    });
+    timed("параллельно (" + threads + "): контрольная сумма", [&]() {
+        return reducer.Checksum(strip, 0, cells - 1);
+    });
+}
+
+/**
+ * Повторная генерация префикса из count элементов против загрузки через mmap
+ */
+void RunWarmLoadBenchmark(size_t count) {
+    // Генератор, имитирующий дорогую симуляцию
+    auto make_generator = []() {
+        uint64_t state = 1;
+        return FunctionGenerator<uint32_t>([state]() mutable {
+            for (int round = 0; round < 64; ++round) {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            }
+            return static_cast<uint32_t>(state >> 33);
+        });
+    };
+    auto path = (std::filesystem::temp_directory_path() / "lazyseq_warm_load_benchmark.bin").string();
+
+    auto start = std::chrono::steady_clock::now();
+    LazySeq<uint32_t, FunctionGenerator<uint32_t>, ArraySeqMem<uint32_t>> cold(make_generator(), ArraySeqMem<uint32_t>());
+    uint32_t cold_last = cold.Get(count - 1)->get();
+    double generate_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    cold.SaveMaterialized(path);
+    double save_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    LazySeq<uint32_t, FunctionGenerator<uint32_t>, MappedSeqMem<uint32_t>> warm(
+        make_generator(), MappedSeqMem<uint32_t>::Load(path));
+    uint32_t warm_last = warm.Get(count - 1)->get();
+    double load_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Элементов: " << count << " (" << count * sizeof(uint32_t) / (1024 * 1024) << " МБ)"
+              << std::fixed << std::setprecision(4)
+              << ": генерация " << generate_seconds << " с, сохранение " << save_seconds
+              << " с, загрузка и чтение последнего " << load_seconds << " с"
+              << (warm_last == cold_last ? "" : " (РАСХОЖДЕНИЕ)") << std::defaultfloat << std::endl;
+    std::filesystem::remove(path);
+}
+
+/**
+ * Интерпретатор против JIT на машине бенчмарка лент (компиляция считается отдельно)
+ */
+void RunJitBenchmark(const TapeBenchmark& benchmark) {
+    MachineDefinition<int, char> definition{0, '_', {}, {FINAL_STATE}};
+    benchmark.rules([&definition](int from, char read, int to, char write, Direction direction) {
+        definition.rules.emplace_back(from, read, to, write, direction);
+    });
+    std::atomic<bool> no_cancel{false};
+
+    auto report = [&](const std::string& engine, const EngineOutcome<int, char>& outcome, double seconds) {
+        std::cout << std::left << std::setw(20) << benchmark.name
+                  << std::setw(14) << engine
+                  << std::right << std::setw(12) << outcome.steps
+                  << std::setw(10) << std::fixed << std::setprecision(3) << seconds
+                  << std::setw(12) << std::setprecision(1) << static_cast<double>(outcome.steps) / seconds / 1e6
+                  << std::defaultfloat << std::endl;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    auto expected = InterpreterEngine<int, char>().Execute(definition, benchmark.input, benchmark.max_steps, no_cancel);
+    report("interpreter", expected, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+    start = std::chrono::steady_clock::now();
+    JitProgram<int, char> program(definition);
+    double compile_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    auto actual = JitEngine<int, char>().Execute(program, benchmark.input, benchmark.max_steps, no_cancel);
+    report(program.IsCompiled() ? "jit" : "jit (нет)", actual,
+           std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    std::cout << "    компиляция " << std::fixed << std::setprecision(1) << compile_seconds * 1e6 << " мкс, код "
+              << program.GetCodeSize() << " байт" << std::defaultfloat
+              << (actual.SameAs(expected) ? "" : " (РАСХОЖДЕНИЕ)") << std::endl;
+}
+
+int main() {
+    const size_t N = 1000000;
+
+    std::vector<TapeBenchmark> benchmarks;
+
+    // Пример 1: инвертирование бинарной строки
+    std::vector<char> bits(N);
+    for (size_t i = 0; i < N; ++i) bits[i] = (i % 3 == 0) ? '1' : '0';
+    benchmarks.push_back({"inverter", bits, 10 * N, [](auto add) {
+        add(0, '0', 0, '1', Direction::RIGHT);
+        add(0, '1', 0, '0', Direction::RIGHT);
+        add(0, '_', FINAL_STATE, '_', Direction::STAY);
+    }});
+
+    // Пример 2: сложение в унарном коде
+    std::vector<char> unary(N, '1');
+    unary[N / 2] = '+';
+    benchmarks.push_back({"unary-addition", unary, 10 * N, [](auto add) {
+        add(0, '1', 0, '1', Direction::RIGHT);
+        add(0, '+', 1, '1', Direction::RIGHT);
+        add(1, '1', 1, '1', Direction::RIGHT);
+        add(1, '_', 2, '_', Direction::LEFT);
+        add(2, '1', FINAL_STATE, '_', Direction::STAY);
+    }});
+
+    // Пример 3: проход палиндрома до конца и назад
+    std::vector<char> word(N);
+    for (size_t i = 0; i < N; ++i) word[i] = (i % 2 == 0) ? 'a' : 'b';
+    benchmarks.push_back({"palindrome-scan", word, 10 * N, [](auto add) {
+        add(0, 'a', 1, 'a', Direction::RIGHT);
+        add(0, 'b', 1, 'b', Direction::RIGHT);
+        add(1, 'a', 1, 'a', Direction::RIGHT);
+        add(1, 'b', 1, 'b', Direction::RIGHT);
+        add(1, '_', 2, '_', Direction::LEFT);
+        add(2, 'a', FINAL_STATE, 'a', Direction::STAY);
+        add(2, 'b', FINAL_STATE, 'b', Direction::STAY);
+    }});
+
+    // Пример 4: уход вправо по пустой ленте
+    benchmarks.push_back({"lazy-mover", {'S', 'T', 'A', 'R', 'T'}, 5 * N, [](auto add) {
+        add(0, 'S', 1, 'X', Direction::RIGHT);
+        for (char c : {'T', 'A', 'R', '_'}) {
+            add(1, c, 1, c, Direction::RIGHT);
+        }
+    }});
+
+    // Зигзаг: головка ходит между растущими краями отрезка единиц
+    benchmarks.push_back({"zig-zag", {}, 20 * N, [](auto add) {
+        add(0, '1', 0, '1', Direction::RIGHT);
+        add(0, '_', 1, '1', Direction::LEFT);
+        add(1, '1', 1, '1', Direction::LEFT);
+        add(1, '_', 0, '1', Direction::RIGHT);
+    }});
+
+    std::cout << "Бенчмарк хранилищ ленты" << std::endl;
+    // setw считает байты, а не символы, поэтому заголовок выровнен вручную
+    std::cout << "машина              лента              шагов       сек      Мшаг/с       ячеек" << std::endl;
+
+    for (const auto& benchmark : benchmarks) {
+        RunTapeBenchmark<LazyMapTapeStorage<char>>(benchmark, "map");
+        RunTapeBenchmark<ChunkedTapeStorage<char>>(benchmark, "chunked");
+        RunTapeBenchmark<GapBufferTapeStorage<char>>(benchmark, "gap");
+    }
+
+    std::cout << std::endl << "Бенчмарк кодирования лент" << std::endl;
+    RunTapeCodecBenchmark(2, 20000);
+    RunTapeCodecBenchmark(3, 200);
+
+    std::cout << std::endl << "Бенчмарк дедупликации блоков ленты" << std::endl;
+    RunDedupBenchmark();
+
+    std::cout << std::endl << "Бенчмарк прохода LazySeq" << std::endl;
+    RunLazySeqScanBenchmark(10000000);
+
+    std::cout << std::endl << "Бенчмарк параллельных свёрток по ленте" << std::endl;
+    RunParallelReduceBenchmark(1000000000);
+
+    std::cout << std::endl << "Бенчмарк тёплого старта LazySeq" << std::endl;
+    RunWarmLoadBenchmark(1000000);
+    RunWarmLoadBenchmark(10000000);
+
+    std::cout << std::endl << "Бенчмарк JIT-компиляции" << std::endl;
+    std::cout << "машина              движок              шагов       сек      Мшаг/с" << std::endl;
+    for (const auto& benchmark : benchmarks) {
+        RunJitBenchmark(benchmark);
+    }
+
+    return 0;
+}
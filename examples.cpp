@@ -1,4 +1,7 @@
 #include "MT.h"
+#include "MachineEnumerator.h"
+#include "DeciderPipeline.h"
+#include "BatchScheduler.h"
 #include <iostream>
 #include <vector>
 #include <string>
@@ -214,10 +217,105 @@ void ExampleLazySeqEfficiency() {
     std::cout << "Символ на позиции 1000: " << tm.GetSymbolAt(1000) << std::endl;
     std::cout << "Символ на позиции -50: " << tm.GetSymbolAt(-50) << std::endl;
     
+    // Пустой хвост после входа не материализуется: в памяти только сам вход
+    std::cout << "Материализовано ячеек LazySeq: " << tm.GetStrip().GetMaterializedCount()
+              << " (размер входа: " << input.size() << ")" << std::endl;
+    std::cout << "Записанных ячеек: " << tm.GetStrip().GetModificationsCount() << std::endl;
+    
     tm.PrintStatistics();
     std::cout << std::endl;
 }
 
+/**
+ * Пример 5: Перечисление машин с отсечением симметрий
+ * Сравнивает количество таблиц с отсечением и без него для малых n
+ */
+void ExampleSymmetryPruning() {
+    std::cout << "=== Пример 5: Перечисление машин с отсечением симметрий ===" << std::endl;
+    
+    for (int states = 1; states <= 3; ++states) {
+        MachineEnumerator enumerator(states, 2);
+        
+        size_t all = enumerator.Enumerate([](const MachineEnumerator::Table&) {}, false);
+        size_t canonical = enumerator.Enumerate([](const MachineEnumerator::Table&) {}, true);
+        
+        std::cout << "n = " << states << ", k = 2: всего " << all
+                  << ", канонических " << canonical
+                  << " (группа симметрий: " << enumerator.GetSymmetryGroupSize()
+                  << ", сокращение в " << static_cast<double>(all) / static_cast<double>(canonical)
+                  << " раз)" << std::endl;
+    }
+    
+    std::cout << std::endl;
+}
+
+/**
+ * Пример 6: Конвейер децайдеров с нарастающим бюджетом
+ * Дорогие стадии получают только машины, не решённые дешёвыми
+ */
+void ExampleDeciderPipeline() {
+    std::cout << "=== Пример 6: Конвейер децайдеров (n = 2, k = 2) ===" << std::endl;
+    
+    MachineEnumerator enumerator(2, 2);
+    std::vector<CandidateMachine> machines;
+    enumerator.Enumerate([&](const MachineEnumerator::Table& table) {
+        machines.push_back({machines.size(), 2, 2, table});
+    });
+    
+    auto pipeline = DeciderPipeline::MakeDefault(2);
+    auto results = pipeline.Run(machines);
+    
+    size_t halting = 0, non_halting = 0, undecided = 0;
+    for (const auto& result : results) {
+        switch (result.verdict) {
+            case DeciderVerdict::HALTS: halting++; break;
+            case DeciderVerdict::NON_HALTING: non_halting++; break;
+            case DeciderVerdict::UNDECIDED: undecided++; break;
+        }
+    }
+    
+    std::cout << "Машин: " << machines.size() << ", останавливаются: " << halting
+              << ", не останавливаются: " << non_halting << ", не решено: " << undecided << std::endl;
+    pipeline.PrintMetrics();
+    std::cout << std::endl;
+}
+
+/**
+ * Пример 7: Политики планирования на смешанной нагрузке
+ * Короткие интерактивные задания с жёсткими сроками против длинных пакетных
+ */
+void ExampleBatchScheduling() {
+    std::cout << "=== Пример 7: Планирование пакета (priority / EDF / fair share) ===" << std::endl;
+    
+    std::vector<ScheduledJob<int, int>> jobs;
+    for (size_t i = 0; i < 48; ++i) {
+        bool interactive = (i % 4 != 0);
+        size_t length = interactive ? 2000 : 400000;
+        ScheduledJob<int, int> job{{0, 0, {}, {1}}, std::vector<int>(length, 1), 1000000,
+                                   interactive ? 10 : 0, interactive ? 0.1 : 5.0,
+                                   interactive ? "interactive" : "bulk"};
+        job.machine.rules.emplace_back(0, 1, 0, 1, Direction::RIGHT);
+        job.machine.rules.emplace_back(0, 0, 1, 0, Direction::RIGHT);
+        jobs.push_back(std::move(job));
+    }
+    
+    auto fair_policy = std::make_unique<FairSharePolicy>();
+    fair_policy->SetWeight("interactive", 4.0);
+    
+    std::vector<std::unique_ptr<ISchedulingPolicy>> policies;
+    policies.push_back(std::make_unique<PrioritySchedulingPolicy>());
+    policies.push_back(std::make_unique<EarliestDeadlinePolicy>());
+    policies.push_back(std::move(fair_policy));
+    
+    for (auto& policy : policies) {
+        ParallelBatchExecutor<int, int> executor(4, 10000, std::move(policy));
+        executor.Run(jobs);
+        executor.PrintMetrics();
+    }
+    
+    std::cout << std::endl;
+}
+
 /**
  * Главная функция
  */
@@ -230,6 +328,9 @@ int main() {
         ExampleUnaryAddition();
         ExampleSimplePalindrome();
         ExampleLazySeqEfficiency();
+        ExampleSymmetryPruning();
+        ExampleDeciderPipeline();
+        ExampleBatchScheduling();
         
         std::cout << "🎉 Все примеры выполнены успешно!" << std::endl;
         std::cout << "
@@ -0,0 +1,402 @@
+#include "MT.h"
+#include "ExecutionEngines.h"
+#include "BatchScheduler.h"
+#include "NondeterministicSearch.h"
+#include "ResourceUsage.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#if defined(__linux__)
+#define SCALING_USE_AFFINITY 1
+#include <pthread.h>
+#include <sched.h>
+#else
+#define SCALING_USE_AFFINITY 0
+#endif
+
+/**
+ * Бенчмарк масштабируемости по числу потоков
+ * Фиксированная нагрузка из эталонных машин (инвертор, унарное сложение,
+ * проход палиндрома, зигзаг) прогоняется на 1, 2, 4, ... N потоках:
+ * - interpreter: пул потоков, задания разбираются по атомарному счётчику;
+ * - streaming: StreamingBatchRunner, задания подаёт главный поток;
+ * - nondeterministic: параллельный IDDFS по дереву угадывания слова.
+ * Для каждого числа потоков печатается строка CSV: пропускная способность,
+ * ускорение и эффективность относительно одного потока, загрузка потоков
+ * (процессорное время потока / время прогона). Перед замерами идут
+ * прогревочные прогоны, из замеров берётся медиана по времени.
+ *
+ * Использование: scalability [--threads N] [--warmup K] [--repeat R]
+ *                            [--jobs M] [--cells C] [--depth D] [--no-pin] [--output файл.csv]
+ */
+
+struct ScalingOptions {
+    size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t warmup = 1;       // Прогревочных прогонов на каждое число потоков
+    size_t repeat = 3;       // Замеряемых прогонов (берётся медиана)
+    size_t jobs = 256;       // Заданий в нагрузке
+    size_t cells = 20000;    // Длина входа задания
+    size_t depth = 18;       // Глубина дерева для nondeterministic
+    bool pin = true;         // Закреплять рабочие потоки за ядрами
+    std::string output;      // Файл CSV (по умолчанию stdout)
+};
+
+/**
+ * Один прогон: выполненная работа (шаги или конфигурации) и занятость потоков
+ */
+struct ScalingSample {
+    double wall_seconds = 0.0;
+    uint64_t work = 0;
+    std::vector<double> busy_seconds;   // Процессорное время каждого рабочего потока
+    double cpu_seconds = 0.0;           // Если по потокам не измерить - время процесса
+};
+
+/**
+ * Закрепление потоков за ядрами из маски, доступной процессу
+ */
+class CpuPinner {
+private:
+    std::vector<int> cpus_;
+    bool enabled_;
+
+public:
+    explicit CpuPinner(bool enabled) : enabled_(enabled) {
+#if SCALING_USE_AFFINITY
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        if (::sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &mask)) cpus_.push_back(cpu);
+            }
+        }
+#endif
+        if (cpus_.empty()) enabled_ = false;
+    }
+
+    bool IsEnabled() const {
+        return enabled_;
+    }
+
+    /**
+     * Закрепить текущий поток за ядром номер slot (по кругу)
+     */
+    void Pin(size_t slot) const {
+        if (!enabled_) return;
+#if SCALING_USE_AFFINITY
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        CPU_SET(cpus_[slot % cpus_.size()], &mask);
+        ::pthread_setaffinity_np(::pthread_self(), sizeof(mask), &mask);
+#else
+        (void)slot;
+#endif
+    }
+};
+
+const int FINAL_STATE = -1;
+
+/**
+ * Задания нагрузки: эталонные машины по очереди, каждая на входе длины cells
+ */
+std::vector<StreamJob<int, char>> MakeWorkload(const ScalingOptions& options) {
+    std::vector<MachineDefinition<int, char>> machines(4, MachineDefinition<int, char>{0, '_', {}, {FINAL_STATE}});
+    machines[0].rules = {{0, '0', 0, '1', Direction::RIGHT}, {0, '1', 0, '0', Direction::RIGHT},
+                         {0, '_', FINAL_STATE, '_', Direction::STAY}};
+    machines[1].rules = {{0, '1', 0, '1', Direction::RIGHT}, {0, '+', 1, '1', Direction::RIGHT},
+                         {1, '1', 1, '1', Direction::RIGHT}, {1, '_', 2, '_', Direction::LEFT},
+                         {2, '1', FINAL_STATE, '_', Direction::STAY}};
+    machines[2].rules = {{0, 'a', 1, 'a', Direction::RIGHT}, {0, 'b', 1, 'b', Direction::RIGHT},
+                         {1, 'a', 1, 'a', Direction::RIGHT}, {1, 'b', 1, 'b', Direction::RIGHT},
+                         {1, '_', 2, '_', Direction::LEFT}, {2, 'a', FINAL_STATE, 'a', Direction::STAY},
+                         {2, 'b', FINAL_STATE, 'b', Direction::STAY}};
+    machines[3].rules = {{0, '1', 0, '1', Direction::RIGHT}, {0, '_', 1, '1', Direction::LEFT},
+                         {1, '1', 1, '1', Direction::LEFT}, {1, '_', 0, '1', Direction::RIGHT}};
+
+    size_t n = options.cells;
+    std::vector<char> bits(n);
+    std::vector<char> unary(n, '1');
+    std::vector<char> word(n);
+    for (size_t i = 0; i < n; ++i) {
+        bits[i] = (i % 3 == 0) ? '1' : '0';
+        word[i] = (i % 2 == 0) ? 'a' : 'b';
+    }
+    unary[n / 2] = '+';
+    std::vector<std::vector<char>> inputs = {bits, unary, word, {}};
+
+    std::vector<StreamJob<int, char>> jobs;
+    for (size_t j = 0; j < options.jobs; ++j) {
+        jobs.push_back({j, machines[j % machines.size()], inputs[j % inputs.size()], 2 * n});
+    }
+    return jobs;
+}
+
+/**
+ * Пул потоков: каждый поток берёт следующее задание по атомарному счётчику
+ */
+ScalingSample RunInterpreterPool(const std::vector<StreamJob<int, char>>& jobs, size_t threads,
+                                 const CpuPinner& pinner) {
+    ScalingSample sample;
+    sample.busy_seconds.assign(threads, 0.0);
+    std::vector<uint64_t> steps(threads, 0);
+    std::atomic<size_t> next{0};
+    std::atomic<bool> no_cancel{false};
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            pinner.Pin(t);
+            int64_t cpu_start = ThreadCpuNanos();
+            InterpreterEngine<int, char> engine;
+            for (size_t j = next.fetch_add(1); j < jobs.size(); j = next.fetch_add(1)) {
+                steps[t] += engine.Execute(jobs[j].machine, jobs[j].input, jobs[j].max_steps, no_cancel).steps;
+            }
+            sample.busy_seconds[t] = static_cast<double>(ThreadCpuNanos() - cpu_start) / 1e9;
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    sample.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (uint64_t count : steps) sample.work += count;
+    return sample;
+}
+
+/**
+ * Интерпретатор, считающий процессорное время каждого вызвавшего его потока
+ * (потоки StreamingBatchRunner создаются внутри него, поэтому закрепление
+ * за ядрами тоже делается при первом вызове в потоке)
+ */
+class MeasuredEngine : public IExecutionEngine<int, char> {
+private:
+    InterpreterEngine<int, char> engine_;
+    const CpuPinner& pinner_;
+    mutable std::mutex mutex_;
+    mutable std::vector<double> busy_seconds_;
+    mutable std::atomic<size_t> next_slot_{0};
+
+public:
+    MeasuredEngine(size_t threads, const CpuPinner& pinner) : pinner_(pinner), busy_seconds_(threads, 0.0) {}
+
+    std::string GetName() const override {
+        return "measured-interpreter";
+    }
+
+    EngineOutcome<int, char> Execute(const MachineDefinition<int, char>& machine,
+                                     const std::vector<char>& input,
+                                     size_t max_steps,
+                                     const std::atomic<bool>& cancel) const override {
+        thread_local const MeasuredEngine* owner = nullptr;
+        thread_local size_t slot = 0;
+        if (owner != this) {
+            owner = this;
+            slot = next_slot_.fetch_add(1) % busy_seconds_.size();
+            pinner_.Pin(slot);
+        }
+        int64_t cpu_start = ThreadCpuNanos();
+        auto outcome = engine_.Execute(machine, input, max_steps, cancel);
+        double busy = static_cast<double>(ThreadCpuNanos() - cpu_start) / 1e9;
+        std::lock_guard<std::mutex> lock(mutex_);
+        busy_seconds_[slot] += busy;
+        return outcome;
+    }
+
+    std::vector<double> GetBusySeconds() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return busy_seconds_;
+    }
+};
+
+/**
+ * Потоковый исполнитель: главный поток подаёт задания и забирает результаты
+ */
+ScalingSample RunStreaming(const std::vector<StreamJob<int, char>>& jobs, size_t threads, const CpuPinner& pinner) {
+    ScalingSample sample;
+    auto engine = std::make_unique<MeasuredEngine>(threads, pinner);
+    const MeasuredEngine& measured = *engine;
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        StreamingBatchRunner<int, char> runner(threads, 64, std::move(engine));
+        std::thread consumer([&]() {
+            StreamJobResult<int, char> result;
+            while (runner.Next(result)) {
+                sample.work += result.outcome.steps;
+            }
+        });
+        for (const auto& job : jobs) {
+            runner.Submit(job);
+        }
+        runner.CloseIntake();
+        consumer.join();
+        sample.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        sample.busy_seconds = measured.GetBusySeconds();
+    }
+    return sample;
+}
+
+/**
+ * Параллельный IDDFS: работа - число посещённых конфигураций
+ * (потоки создаются внутри перебора и не закрепляются; загрузка - по
+ * процессорному времени процесса)
+ */
+ScalingSample RunNondeterministic(size_t depth, size_t threads) {
+    TransitionManager<int, char> writer;
+    writer.AddNondeterministicRule(0, '_', 0, 'a', Direction::RIGHT);
+    writer.AddNondeterministicRule(0, '_', 0, 'b', Direction::RIGHT);
+    NondeterministicExplorer<int, char> explorer(writer, 0, '_', {FINAL_STATE});
+    ExplorationOptions options;
+    options.max_depth = depth;
+    options.initial_depth = depth;
+    options.threads = threads;
+    options.transposition_entries = 1 << 16;
+
+    ScalingSample sample;
+    std::clock_t cpu_start = std::clock();
+    auto start = std::chrono::steady_clock::now();
+    sample.work = explorer.Explore({}, options).explored;
+    sample.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    sample.cpu_seconds = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+    return sample;
+}
+
+/**
+ * Прогнать одно число потоков: прогрев, затем медиана из repeat замеров
+ */
+ScalingSample Measure(const ScalingOptions& options, const std::function<ScalingSample()>& run) {
+    for (size_t i = 0; i < options.warmup; ++i) {
+        run();
+    }
+    std::vector<ScalingSample> samples;
+    for (size_t i = 0; i < std::max<size_t>(1, options.repeat); ++i) {
+        samples.push_back(run());
+    }
+    std::sort(samples.begin(), samples.end(), [](const ScalingSample& a, const ScalingSample& b) {
+        return a.wall_seconds < b.wall_seconds;
+    });
+    return samples[samples.size() / 2];
+}
+
+/**
+ * 1, 2, 4, ... и max_threads, если это не степень двойки
+ */
+std::vector<size_t> ThreadCounts(size_t max_threads) {
+    std::vector<size_t> counts;
+    for (size_t threads = 1; threads < max_threads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(max_threads);
+    return counts;
+}
+
+void Sweep(const std::string& feature, const ScalingOptions& options, std::ostream& csv,
+           const std::function<ScalingSample(size_t)>& run) {
+    double baseline = 0.0;
+    for (size_t threads : ThreadCounts(options.max_threads)) {
+        ScalingSample sample = Measure(options, [&]() { return run(threads); });
+        double throughput = static_cast<double>(sample.work) / std::max(sample.wall_seconds, 1e-9);
+        if (threads == 1) baseline = throughput;
+        double speedup = baseline > 0.0 ? throughput / baseline : 0.0;
+
+        std::ostringstream per_thread;
+        double cpu_seconds = sample.cpu_seconds;
+        for (size_t t = 0; t < sample.busy_seconds.size(); ++t) {
+            per_thread << (t ? ";" : "") << std::fixed << std::setprecision(3)
+                       << sample.busy_seconds[t] / std::max(sample.wall_seconds, 1e-9);
+            cpu_seconds += sample.busy_seconds[t];
+        }
+        double utilization = cpu_seconds / (std::max(sample.wall_seconds, 1e-9) * static_cast<double>(threads));
+
+        csv << feature << ',' << threads << ',' << sample.work << ','
+            << std::fixed << std::setprecision(6) << sample.wall_seconds << ','
+            << std::setprecision(0) << throughput << ','
+            << std::setprecision(3) << speedup << ',' << speedup / static_cast<double>(threads) << ','
+            << utilization << ",\"" << per_thread.str() << '"' << std::defaultfloat << std::endl;
+        std::cerr << feature << ": " << threads << " пот. - " << std::fixed << std::setprecision(2)
+                  << throughput / 1e6 << " М/с, ускорение " << speedup << std::defaultfloat << std::endl;
+    }
+}
+
+bool ParseOptions(int argc, char** argv, ScalingOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+        auto number = [&](size_t& target) {
+            const char* text = value();
+            if (!text) return false;
+            target = static_cast<size_t>(std::strtoull(text, nullptr, 10));
+            return true;
+        };
+        bool ok = true;
+        if (arg == "--threads") ok = number(options.max_threads);
+        else if (arg == "--warmup") ok = number(options.warmup);
+        else if (arg == "--repeat") ok = number(options.repeat);
+        else if (arg == "--jobs") ok = number(options.jobs);
+        else if (arg == "--cells") ok = number(options.cells);
+        else if (arg == "--depth") ok = number(options.depth);
+        else if (arg == "--no-pin") options.pin = false;
+        else if (arg == "--output") {
+            const char* text = value();
+            ok = text != nullptr;
+            if (ok) options.output = text;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::cerr << "Использование: " << argv[0] << " [--threads N] [--warmup K] [--repeat R] [--jobs M]"
+                      << " [--cells C] [--depth D] [--no-pin] [--output файл.csv]" << std::endl;
+            return false;
+        }
+    }
+    options.max_threads = std::max<size_t>(1, options.max_threads);
+    options.cells = std::max<size_t>(2, options.cells);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    ScalingOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file) {
+            std::cerr << "Не удалось открыть " << options.output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& csv = options.output.empty() ? std::cout : file;
+
+    CpuPinner pinner(options.pin);
+    auto jobs = MakeWorkload(options);
+    std::cerr << "Потоков до " << options.max_threads << ", заданий " << jobs.size()
+              << ", прогрев " << options.warmup << ", замеров " << options.repeat
+              << (pinner.IsEnabled() ? ", потоки закреплены" : ", без закрепления") << std::endl;
+
+    csv << "feature,threads,work,wall_seconds,work_per_second,speedup,efficiency,utilization,thread_utilization"
+        << std::endl;
+    Sweep("interpreter", options, csv, [&](size_t threads) {
+        return RunInterpreterPool(jobs, threads, pinner);
+    });
+    Sweep("streaming", options, csv, [&](size_t threads) {
+        return RunStreaming(jobs, threads, pinner);
+    });
+    Sweep("nondeterministic", options, csv, [&](size_t threads) {
+        return RunNondeterministic(options.depth, threads);
+    });
+    return 0;
+}
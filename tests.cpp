@@ -1,9 +1,30 @@
+// Подсчёт выделений памяти в тестах (operator new замещается в этой единице трансляции)
+#define TURING_ALLOCATION_COUNTER_IMPLEMENTATION
 #include "MT.h"
+#include "MachineEnumerator.h"
+#include "DeciderPipeline.h"
+#include "BackwardReasoning.h"
+#include "PortfolioRunner.h"
+#include "StepEscalation.h"
+#include "BatchScheduler.h"
+#include "TapeCodec.h"
+#include "ChunkStore.h"
+#include "ParallelReduce.h"
+#include "JitEngine.h"
+#include "NondeterministicSearch.h"
 #include <iostream>
 #include <vector>
 #include <string>
 #include <cassert>
 #include <sstream>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <map>
 
 /**
  * Простая система модульных тестов
@@ -351,6 +372,1421 @@ bool TestExecutionStatistics() {
     return true;
 }
 
+/**
+ * Тест неявного пустого хвоста ленты: чтение за концом входа не материализует ячейки
+ */
+bool TestImplicitBlankTail() {
+    TuringStrip<char> strip('_', {'a', 'b', 'c'});
+    
+    // Проход только на чтение далеко за пределы входных данных
+    for (int i = 0; i < 10000; ++i) {
+        char expected = (i < 3) ? "abc"[i] : '_';
+        if (strip.GetSymbolAt(i) != expected) return false;
+    }
+    if (strip.GetMaterializedCount() != 3) return false;
+    if (strip.GetImplicitBlankStart() != 3) return false;
+    
+    // Запись в хвост видна при чтении, соседние ячейки остаются пустыми
+    strip.SetSymbolAt(5000, 'X');
+    if (strip.GetSymbolAt(5000) != 'X') return false;
+    if (strip.GetSymbolAt(4999) != '_') return false;
+    if (strip.GetMaterializedCount() != 3) return false;
+    
+    return true;
+}
+
+/**
+ * Тест канонизации: изоморфные машины имеют одного представителя
+ */
+bool TestSymmetryCanonicalization() {
+    MachineEnumerator enumerator(2, 2);
+    
+    // Машина и её зеркальная копия с переставленными состояниями
+    TransitionManager<int, int> original;
+    original.AddRule(0, 0, 1, 1, Direction::RIGHT);
+    original.AddRule(1, 0, 0, 1, Direction::LEFT);
+    original.AddRule(1, 1, 1, 0, Direction::RIGHT);
+    
+    TransitionManager<int, int> mirrored;
+    mirrored.AddRule(0, 0, 1, 1, Direction::LEFT);
+    mirrored.AddRule(1, 0, 0, 1, Direction::RIGHT);
+    mirrored.AddRule(1, 1, 1, 0, Direction::LEFT);
+    
+    auto lhs = enumerator.Canonicalize(enumerator.FromTransitionManager(original));
+    auto rhs = enumerator.Canonicalize(enumerator.FromTransitionManager(mirrored));
+    if (!(lhs == rhs)) return false;
+    
+    // Каждая выданная таблица каноническая, а отсечение не больше размера группы
+    size_t all = enumerator.Enumerate([](const MachineEnumerator::Table&) {}, false);
+    bool all_canonical = true;
+    size_t canonical = enumerator.Enumerate([&](const MachineEnumerator::Table& table) {
+        if (!(enumerator.Canonicalize(table) == table)) all_canonical = false;
+    }, true);
+    
+    if (!all_canonical) return false;
+    if (all != enumerator.GetTotalTablesCount()) return false;
+    return canonical < all && canonical * enumerator.GetSymmetryGroupSize() >= all;
+}
+
+/**
+ * Тест конвейера децайдеров: вердикты корректны, дальше уходят только нерешённые
+ */
+bool TestDeciderPipeline() {
+    MachineEnumerator enumerator(2, 2);
+    std::vector<CandidateMachine> machines;
+    enumerator.Enumerate([&](const MachineEnumerator::Table& table) {
+        machines.push_back({machines.size(), 2, 2, table});
+    });
+    
+    DeciderPipeline pipeline(16);  // Маленькие очереди проверяют обратное давление
+    SimulationDecider short_sim(50);
+    CyclerDecider cycler(500);
+    TranslatedCyclerDecider translated(2000);
+    pipeline.AddStage("short", 2, [&](const CandidateMachine& m) { return short_sim.Decide(m); });
+    pipeline.AddStage("cycler", 2, [&](const CandidateMachine& m) { return cycler.Decide(m); });
+    pipeline.AddStage("translated", 2, [&](const CandidateMachine& m) { return translated.Decide(m); });
+    
+    auto results = pipeline.Run(machines);
+    if (results.size() != machines.size()) return false;
+    
+    // Доказанно незавершающиеся машины не должны останавливаться при длинной симуляции
+    SimulationDecider check(10000);
+    for (size_t i = 0; i < machines.size(); ++i) {
+        if (results[i].machine_id != machines[i].id) return false;
+        if (results[i].verdict == DeciderVerdict::NON_HALTING &&
+            check.Decide(machines[i]) == DeciderVerdict::HALTS) return false;
+        if (results[i].verdict == DeciderVerdict::HALTS &&
+            check.Decide(machines[i]) != DeciderVerdict::HALTS) return false;
+    }
+    
+    const auto& metrics = pipeline.GetStageMetrics();
+    if (metrics.size() != 3) return false;
+    if (metrics[0].received != machines.size()) return false;
+    for (size_t s = 0; s + 1 < metrics.size(); ++s) {
+        if (metrics[s].received != metrics[s].decided + metrics[s].escalated) return false;
+        if (metrics[s + 1].received != metrics[s].escalated) return false;
+    }
+    
+    return true;
+}
+
+/**
+ * Тест обратного анализа: сертификаты проверяемы, останавливающиеся машины не отсекаются
+ */
+bool TestBackwardReasoning() {
+    BackwardReasoningAnalyzer analyzer(20);
+    
+    // Остановка только в (1, 1); все обратные ветви от неё погибают за три шага
+    TransitionManager<int, int> rules;
+    rules.AddRule(0, 0, 1, 1, Direction::LEFT);
+    rules.AddRule(0, 1, 0, 0, Direction::RIGHT);
+    rules.AddRule(1, 0, 0, 1, Direction::RIGHT);
+    auto never = analyzer.Analyze(rules, 2, 2);
+    if (never.verdict != DeciderVerdict::NON_HALTING) return false;
+    if (never.certificate.depth != 3) return false;
+    
+    MachineEnumerator enumerator(2, 2);
+    std::vector<CandidateMachine> machines;
+    enumerator.Enumerate([&](const MachineEnumerator::Table& table) {
+        machines.push_back({machines.size(), 2, 2, table});
+    });
+    
+    auto results = analyzer.AnalyzeAll(machines, 4);
+    SimulationDecider simulation(10000);
+    size_t proven = 0;
+    for (size_t i = 0; i < machines.size(); ++i) {
+        if (results[i].verdict != DeciderVerdict::NON_HALTING) continue;
+        proven++;
+        if (simulation.Decide(machines[i]) == DeciderVerdict::HALTS) return false;
+        if (!BackwardReasoningAnalyzer::VerifyCertificate(machines[i], results[i].certificate)) return false;
+    }
+    
+    return proven > 0;
+}
+
+/**
+ * Тест движков исполнения: интерпретатор, chain step и макромашина дают одинаковый результат
+ */
+bool TestExecutionEnginesAgree() {
+    MachineDefinition<std::string, char> inverter{"START", ' ', {}, {"FINAL"}};
+    inverter.rules.emplace_back("START", '0', "START", '1', Direction::RIGHT);
+    inverter.rules.emplace_back("START", '1', "START", '0', Direction::RIGHT);
+    inverter.rules.emplace_back("START", ' ', "FINAL", ' ', Direction::STAY);
+    
+    InterpreterEngine<std::string, char> interpreter;
+    ChainStepEngine<std::string, char> chain;
+    MacroMachineEngine<std::string, char> macro(3);
+    std::atomic<bool> no_cancel{false};
+    
+    std::vector<char> input = {'1', '1', '1', '0', '0', '1', '0'};
+    for (size_t max_steps : {3, 7, 8, 100}) {
+        auto expected = interpreter.Execute(inverter, input, max_steps, no_cancel);
+        if (!expected.SameAs(chain.Execute(inverter, input, max_steps, no_cancel))) return false;
+        if (!expected.SameAs(macro.Execute(inverter, input, max_steps, no_cancel))) return false;
+    }
+    
+    // Все машины 2x2 на непустом входе
+    MachineEnumerator enumerator(2, 2);
+    InterpreterEngine<int, int> int_interpreter;
+    ChainStepEngine<int, int> int_chain;
+    MacroMachineEngine<int, int> int_macro(2);
+    bool agree = true;
+    enumerator.Enumerate([&](const MachineEnumerator::Table& table) {
+        TransitionManager<int, int> rules;
+        enumerator.ToTransitionManager(table, rules);
+        MachineDefinition<int, int> definition{0, 0, rules.GetAllRules(), {1}};
+        std::vector<int> tape = {1, 1, 0, 1};
+        auto expected = int_interpreter.Execute(definition, tape, 50, no_cancel);
+        agree = agree && expected.SameAs(int_chain.Execute(definition, tape, 50, no_cancel));
+        agree = agree && expected.SameAs(int_macro.Execute(definition, tape, 50, no_cancel));
+    });
+    return agree;
+}
+
+/**
+ * Тест портфельного запуска: победитель запоминается и повторный запуск идёт без гонки
+ */
+bool TestPortfolioRunner() {
+    auto runner = PortfolioRunner<int, int>::MakeDefault();
+    
+    // Бег вправо по пустой ленте: chain step проходит его за один шаг движка
+    MachineDefinition<int, int> runaway{0, 0, {}, {}};
+    runaway.rules.emplace_back(0, 0, 0, 1, Direction::RIGHT);
+    
+    auto first = runner->Run(runaway, {}, 20000000);
+    if (!first.raced) return false;
+    if (first.outcome.result != ExecutionResult::TIMEOUT) return false;
+    if (first.outcome.steps != 20000000) return false;
+    if (runner->GetRecordedWinner(runaway) != first.winner) return false;
+    
+    auto second = runner->Run(runaway, {}, 20000000);
+    if (second.raced) return false;
+    if (second.winner != first.winner) return false;
+    
+    return second.outcome.SameAs(first.outcome);
+}
+
+/**
+ * Тест эскалации лимита шагов с продолжением
+ */
+bool TestStepEscalation() {
+    // Проход по 1000 единицам до пустой ячейки и остановка
+    EscalationJob<int, int> scanner{{0, 0, {}, {1}}, std::vector<int>(1000, 1)};
+    scanner.machine.rules.emplace_back(0, 1, 0, 1, Direction::RIGHT);
+    scanner.machine.rules.emplace_back(0, 0, 1, 0, Direction::RIGHT);
+    
+    // Бесконечный бег влево с записью единиц: лента уходит в отрицательные позиции
+    EscalationJob<int, int> runaway{{0, 0, {}, {}}, {}};
+    runaway.machine.rules.emplace_back(0, 0, 0, 1, Direction::LEFT);
+    
+    std::vector<EscalationJob<int, int>> jobs = {scanner, runaway};
+    std::string spill_directory = std::filesystem::temp_directory_path().string();
+    
+    // Нулевой лимит памяти: все снимки проходят через диск
+    StepEscalator<int, int> escalator(16, 4096, 0, spill_directory);
+    auto results = escalator.Run(jobs);
+    const auto& stats = escalator.GetStatistics();
+    
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        auto machine = jobs[i].machine.Instantiate(jobs[i].input);
+        ExecutionResult direct = machine->Run(4096);
+        if (results[i].result != direct) return false;
+        if (results[i].steps != machine->GetStepCount()) return false;
+    }
+    
+    if (results[0].result != ExecutionResult::ACCEPTED || results[0].steps != 1001) return false;
+    if (results[1].result != ExecutionResult::TIMEOUT || results[1].rounds != 9) return false;
+    if (stats.snapshots_spilled == 0) return false;
+    
+    // Продолжение не повторяет уже выполненные шаги
+    if (stats.steps_executed != results[0].steps + results[1].steps) return false;
+    return stats.steps_executed < stats.steps_if_restarted;
+}
+
+/**
+ * Тест политик планирования пакетного исполнителя
+ */
+bool TestBatchScheduling() {
+    // Проход по входу из единиц до пустой ячейки: length + 1 шагов
+    auto scanner = [](size_t length, int priority, double deadline, const std::string& group) {
+        ScheduledJob<int, int> job{{0, 0, {}, {1}}, std::vector<int>(length, 1), 100000, priority, deadline, group};
+        job.machine.rules.emplace_back(0, 1, 0, 1, Direction::RIGHT);
+        job.machine.rules.emplace_back(0, 0, 1, 0, Direction::RIGHT);
+        return job;
+    };
+    
+    // Один поток делает порядок завершения детерминированным
+    std::vector<ScheduledJob<int, int>> jobs = {
+        scanner(5000, 0, 10.0, "bulk"),
+        scanner(50, 5, 20.0, "interactive"),
+        scanner(3000, 1, 5.0, "bulk"),
+    };
+    
+    ParallelBatchExecutor<int, int> priority(1, 100, std::make_unique<PrioritySchedulingPolicy>());
+    auto by_priority = priority.Run(jobs);
+    if (!(by_priority[1].latency_seconds <= by_priority[2].latency_seconds &&
+          by_priority[2].latency_seconds <= by_priority[0].latency_seconds)) return false;
+    
+    ParallelBatchExecutor<int, int> edf(1, 100, std::make_unique<EarliestDeadlinePolicy>());
+    auto by_deadline = edf.Run(jobs);
+    if (!(by_deadline[2].latency_seconds <= by_deadline[0].latency_seconds &&
+          by_deadline[0].latency_seconds <= by_deadline[1].latency_seconds)) return false;
+    
+    auto fair_policy = std::make_unique<FairSharePolicy>();
+    fair_policy->SetWeight("interactive", 3.0);
+    ParallelBatchExecutor<int, int> fair(2, 100, std::move(fair_policy));
+    auto by_share = fair.Run(jobs);
+    
+    for (const auto& reports : {by_priority, by_deadline, by_share}) {
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            if (reports[i].result != ExecutionResult::ACCEPTED) return false;
+            if (reports[i].steps != jobs[i].input.size() + 1) return false;
+            if (reports[i].slices != (reports[i].steps + 99) / 100) return false;
+        }
+    }
+    
+    return fair.GetMetrics().jobs == 3 && fair.GetMetrics().total_steps == 8053 &&
+           fair.GetMetrics().steps.GetTotalCount() == 3 && fair.GetMetrics().execution_time_us.GetTotalCount() == 3;
+}
+
+/**
+ * Тест хранилищ ленты: gap buffer и блоки ведут себя как хранилище по умолчанию
+ */
+bool TestTapeStorageBackends() {
+    std::vector<char> input = {'a', 'b', 'c', 'd'};
+    TuringStrip<char> reference('_', input);
+    TuringStrip<char, ChunkedTapeStorage<char, 16>> chunked('_', input);
+    TuringStrip<char, GapBufferTapeStorage<char>> gap('_', input);
+    
+    // Блуждание головки с редкими дальними прыжками
+    unsigned seed = 12345;
+    auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return (seed >> 16) & 0x7fff; };
+    int head = 0;
+    for (int i = 0; i < 20000; ++i) {
+        unsigned r = next();
+        head += (r % 100 == 0) ? static_cast<int>(r % 2001) - 1000 : static_cast<int>(r % 3) - 1;
+        char symbol = static_cast<char>('A' + r % 26);
+        reference.SetSymbolAt(head, symbol);
+        chunked.SetSymbolAt(head, symbol);
+        gap.SetSymbolAt(head, symbol);
+        
+        int probe = head + static_cast<int>(next() % 41) - 20;
+        char expected = reference.GetSymbolAt(probe);
+        if (chunked.GetSymbolAt(probe) != expected || gap.GetSymbolAt(probe) != expected) return false;
+    }
+    
+    auto [first, last] = reference.GetUsedRange();
+    for (int position = first - 5; position <= last + 5; ++position) {
+        char expected = reference.GetSymbolAt(position);
+        if (chunked.GetSymbolAt(position) != expected || gap.GetSymbolAt(position) != expected) return false;
+    }
+    
+    // Зигзаг на машине с gap buffer даёт ту же ленту, что и по умолчанию
+    auto zigzag = [](auto& tm) {
+        tm.AddTransition(0, 1, 0, 1, Direction::RIGHT);
+        tm.AddTransition(0, 0, 1, 1, Direction::LEFT);
+        tm.AddTransition(1, 1, 1, 1, Direction::LEFT);
+        tm.AddTransition(1, 0, 0, 1, Direction::RIGHT);
+        return tm.Run(100000);
+    };
+    TuringMachine<int, int> plain(0, 0);
+    TuringMachine<int, int, GapBufferTapeStorage<int>> buffered(0, 0);
+    if (zigzag(plain) != zigzag(buffered)) return false;
+    if (plain.GetHeadPosition() != buffered.GetHeadPosition()) return false;
+    if (plain.GetTapeSegment(-300, 600) != buffered.GetTapeSegment(-300, 600)) return false;
+    
+    // Локальное движение не раздувает буфер
+    const auto& storage = buffered.GetStrip().GetStorage();
+    return storage.GetCapacity() <= 4 * storage.GetStoredCellsCount() + 64;
+}
+
+/**
+ * Тест компактного кодирования ленты: точное восстановление и сжатие
+ */
+bool TestTapeCodec() {
+    unsigned seed = 777;
+    auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return (seed >> 16) & 0x7fff; };
+    
+    // Серии разной длины над алфавитами разного размера, включая отрицательные символы
+    for (int round = 0; round < 200; ++round) {
+        int alphabet = 1 + static_cast<int>(next() % 40);
+        std::vector<int> cells;
+        size_t length = next() % 3000;
+        while (cells.size() < length) {
+            int symbol = static_cast<int>(next() % alphabet) - alphabet / 2;
+            cells.insert(cells.end(), 1 + next() % (round % 2 ? 3 : 100), symbol);
+        }
+        int start = static_cast<int>(next() % 1000) - 500;
+        
+        auto image = TapeCodec<int>::Decode(TapeCodec<int>::Encode(start, cells));
+        if (image.start != start || image.cells != cells) return false;
+    }
+    
+    // Обрезка пустых краёв сдвигает начало
+    std::vector<char> padded(40, '_');
+    padded[17] = '1';
+    padded[20] = '0';
+    auto trimmed = TapeCodec<char>::Decode(TapeCodec<char>::Encode(-10, padded, '_'));
+    if (trimmed.start != 7 || trimmed.cells != std::vector<char>{'1', '_', '_', '0'}) return false;
+    
+    // Длинные серии и двоичный алфавит кодируются гораздо короче сырых данных
+    std::vector<char> runs(100000, '0');
+    std::fill(runs.begin() + 30000, runs.begin() + 70000, '1');
+    if (TapeCodec<char>::Encode(0, runs).size() > 32) return false;
+    std::vector<char> noise(100000);
+    for (auto& cell : noise) cell = (next() % 2) ? '1' : '0';
+    if (TapeCodec<char>::Encode(0, noise).size() > noise.size() / 8 + 32) return false;
+    
+    // Обрезанные данные отвергаются
+    auto encoded = TapeCodec<char>::Encode(0, noise);
+    encoded.resize(encoded.size() / 2);
+    try {
+        TapeCodec<char>::Decode(encoded);
+        return false;
+    } catch (const std::runtime_error&) {
+    }
+    return true;
+}
+
+/**
+ * Тест общего хранилища блоков: дедупликация и copy-on-write
+ */
+bool TestDedupTapeStorage() {
+    using Strip = TuringStrip<char, DedupTapeStorage<char, 64>>;
+    auto store = ChunkStore<char>::GetDefault();
+    store->Collect();
+    size_t before = store->GetStatistics().unique_chunks;
+    
+    // 10 блоков с разным содержимым
+    std::vector<char> input(640);
+    for (size_t i = 0; i < input.size(); ++i) input[i] = static_cast<char>('a' + (i / 64 + i % 7) % 26);
+    
+    {
+        Strip first('_', input);
+        Strip second('_', input);
+        Strip copy = first;
+        if (store->GetStatistics().unique_chunks != before + 10) return false;
+        
+        // Запись видна только в своей ленте
+        first.SetSymbolAt(5, 'X');
+        first.SetSymbolAt(-3, 'Y');
+        if (first.GetSymbolAt(5) != 'X' || second.GetSymbolAt(5) != input[5] || copy.GetSymbolAt(5) != input[5]) return false;
+        if (first.GetSymbolAt(-3) != 'Y' || first.GetSymbolAt(-4) != '_') return false;
+        
+        // Сравнение с хранилищем по умолчанию на случайных записях
+        TuringStrip<char> reference('_', input);
+        reference.SetSymbolAt(5, 'X');
+        reference.SetSymbolAt(-3, 'Y');
+        unsigned seed = 99;
+        for (int i = 0; i < 5000; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            int position = static_cast<int>((seed >> 16) % 1500) - 500;
+            char symbol = static_cast<char>('A' + (seed >> 8) % 3);
+            first.SetSymbolAt(position, symbol);
+            reference.SetSymbolAt(position, symbol);
+        }
+        for (int position = -600; position < 1100; ++position) {
+            if (first.GetSymbolAt(position) != reference.GetSymbolAt(position)) return false;
+            if (second.GetSymbolAt(position) != copy.GetSymbolAt(position)) return false;
+        }
+    }
+    
+    // Блоки умирают вместе с последней ссылающейся на них лентой
+    store->Collect();
+    return store->GetStatistics().unique_chunks == before;
+}
+
+/**
+ * Тест обхода LazySeq непрерывными участками
+ */
+bool TestLazySeqSpans() {
+    // Конечный генератор: участки заканчиваются вместе с ним
+    int next = 0;
+    LazySeq<int, FunctionGenerator<int>, ArraySeqMem<int>> finite(
+        FunctionGenerator<int>([&next]() {
+            if (next >= 10000) throw std::out_of_range("конец");
+            return next++;
+        }),
+        ArraySeqMem<int>());
+
+    long long sum = 0;
+    size_t count = 0;
+    size_t spans = 0;
+    for (auto span : finite.Spans(5, 20000, 1000)) {
+        spans++;
+        for (int value : span) {
+            if (value != static_cast<int>(5 + count)) return false;
+            sum += value;
+            count++;
+        }
+    }
+    if (count != 9995 || spans != 10) return false;
+    if (sum != 49995000LL - 10) return false;
+
+    // Уже материализованное отдаётся одним участком
+    size_t cached_spans = 0;
+    for (auto span : finite.Spans(0, 10000, 16)) {
+        cached_spans++;
+        if (span.size != 10000) return false;
+    }
+    if (cached_spans != 1) return false;
+
+    // Поэлементный диапазон со стандартными алгоритмами
+    auto elements = finite.Elements(100, 200, 7);
+    if (std::accumulate(elements.begin(), elements.end(), 0LL) != (100 + 199) * 100 / 2) return false;
+
+    // Константный хвост не материализуется
+    std::vector<char> data = {'a', 'b', 'c'};
+    LazySeq<char, TapeGenerator<char, std::vector<char>>, ArraySeqMem<char>> tape(
+        TapeGenerator<char, std::vector<char>>(data, '_'), ArraySeqMem<char>());
+    auto cells = tape.Elements(1, 100000, 64);
+    std::string text;
+    for (auto it = cells.begin(); it != cells.end(); ++it) {
+        text.push_back(*it);
+    }
+    if (text.size() != 99999 || text.substr(0, 3) != "bc_") return false;
+    if (std::count(text.begin(), text.end(), '_') != 99997) return false;
+    if (tape.MaterializedCount() != 3) return false;
+
+    // Ограничение длины последовательности
+    LazySeq<char, TapeGenerator<char, std::vector<char>>, ArraySeqMem<char>> bounded(
+        TapeGenerator<char, std::vector<char>>(data, '_'), ArraySeqMem<char>(), 50);
+    size_t bounded_count = 0;
+    for (auto span : bounded.Spans(0, 1000)) bounded_count += span.size;
+    return bounded_count == 50;
+}
+
+/**
+ * Тест параллельных свёрток по ленте и LazySeq
+ */
+bool TestParallelReduce() {
+    std::vector<char> input(5000);
+    unsigned seed = 7;
+    for (auto& cell : input) {
+        seed = seed * 1103515245u + 12345u;
+        cell = static_cast<char>('a' + (seed >> 16) % 4);
+    }
+
+    TuringStrip<char> lazy('_', input);
+    TuringStrip<char, ChunkedTapeStorage<char, 64>> chunked('_', input);
+    TuringStrip<char, GapBufferTapeStorage<char>> gap('_', input);
+    TuringStrip<char, DedupTapeStorage<char, 64>> dedup('_', input);
+    for (int i = 0; i < 300; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        int position = static_cast<int>((seed >> 16) % 9000) - 2000;
+        char symbol = static_cast<char>('a' + (seed >> 8) % 5);
+        lazy.SetSymbolAt(position, symbol);
+        chunked.SetSymbolAt(position, symbol);
+        gap.SetSymbolAt(position, symbol);
+        dedup.SetSymbolAt(position, symbol);
+    }
+
+    // Эталон - последовательный проход через GetSymbolAt
+    const int first = -2500;
+    const int last = 7500;
+    size_t count_b = 0;
+    long long weighted = 0;
+    uint64_t hash = 0;
+    std::optional<int> first_e, last_e;
+    for (int position = first; position <= last; ++position) {
+        char symbol = lazy.GetSymbolAt(position);
+        count_b += symbol == 'b';
+        weighted = weighted * 3 % 1000003 + symbol;
+        hash = hash * 1099511628211ULL + static_cast<uint64_t>(std::hash<char>{}(symbol));
+        if (symbol == 'e') {
+            if (!first_e) first_e = position;
+            last_e = position;
+        }
+    }
+
+    // Результат не зависит от числа потоков и размера блока
+    for (size_t threads : {1, 3, 8}) {
+        for (size_t block : {1, 100, 1 << 16}) {
+            ParallelReducer reducer(threads, block);
+            auto check = [&](const auto& strip) {
+                if (reducer.Count(strip, first, last, 'b') != count_b) return false;
+                if (reducer.Checksum(strip, first, last) != hash) return false;
+                if (reducer.FindFirst(strip, first, last, [](char c) { return c == 'e'; }) != first_e) return false;
+                if (reducer.FindLast(strip, first, last, [](char c) { return c == 'e'; }) != last_e) return false;
+                // Неассоциативная операция, представленная ассоциативной: (значение, множитель)
+                using Affine = std::pair<long long, long long>;
+                auto folded = reducer.TransformReduce(strip, first, last, Affine{0, 1},
+                    [](const Affine& left, const Affine& right) {
+                        return Affine{(left.first * right.second + right.first) % 1000003, left.second * right.second % 1000003};
+                    },
+                    [](char symbol) { return Affine{symbol, 3}; });
+                return folded.first == weighted % 1000003;
+            };
+            if (!check(lazy) || !check(chunked) || !check(gap) || !check(dedup)) return false;
+        }
+    }
+
+    // Свёртка по LazySeq, в том числе по константному хвосту
+    LazySeq<char, TapeGenerator<char, std::vector<char>>, ArraySeqMem<char>> seq(
+        TapeGenerator<char, std::vector<char>>(input, '_'), ArraySeqMem<char>());
+    long long expected = 0;
+    for (size_t i = 10; i < 200000; ++i) expected += std::as_const(seq).Get(i)->get();
+    ParallelReducer reducer(4, 1000);
+    long long sum = reducer.TransformReduce(seq, 10, 200000, 0LL, std::plus<long long>(),
+                                            [](char c) { return static_cast<long long>(c); });
+    return sum == expected && seq.MaterializedCount() == input.size();
+}
+
+/**
+ * Тест склейки источников ConcatGenerator
+ */
+bool TestConcatGenerator() {
+    // Файл с полезной нагрузкой
+    std::vector<int> payload(10000);
+    for (size_t i = 0; i < payload.size(); ++i) payload[i] = static_cast<int>(i * 7 % 101);
+    auto path = std::filesystem::temp_directory_path() / "concat_generator_test.bin";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size() * sizeof(int)));
+    }
+    auto file = MappedFile::Open(path.string());
+
+    std::vector<int> separator = {-1, -2};
+    int counter = 0;
+    auto build = [&]() {
+        counter = 0;
+        ConcatGenerator<int> gen;
+        gen.AddVector(std::vector<int>{1, 2, 3})
+           .AddFile(file, sizeof(int) * 100)
+           .AddSpan(separator.data(), separator.size())
+           .AddGenerator(std::make_unique<FunctionGenerator<int>>([&counter]() { return 1000 + counter++; }), 5)
+           .AddFile(file, 0, 4)
+           .SetFill(0);
+        return gen;
+    };
+
+    std::vector<int> expected = {1, 2, 3};
+    expected.insert(expected.end(), payload.begin() + 100, payload.end());
+    expected.insert(expected.end(), separator.begin(), separator.end());
+    for (int i = 0; i < 5; ++i) expected.push_back(1000 + i);
+    expected.insert(expected.end(), payload.begin(), payload.begin() + 4);
+
+    // Поэлементно
+    auto single = build();
+    for (int value : expected) {
+        if (single.GetNext() != value) return false;
+    }
+    if (single.GetNext() != 0 || !single.HasNext()) return false;
+
+    // Пакетами: участки файла отдаются без копирования
+    auto batched = build();
+    auto [data, count] = batched.NextBatch(2);
+    if (count != 2 || data[1] != 2) return false;
+    std::tie(data, count) = batched.NextBatch(100000);
+    if (count != 1 || data[0] != 3) return false;
+    std::tie(data, count) = batched.NextBatch(100000);
+    if (count != payload.size() - 100 || reinterpret_cast<const unsigned char*>(data) != file->Data() + sizeof(int) * 100) return false;
+
+    // Через LazySeq: пакетная материализация
+    LazySeq<int, ConcatGenerator<int>, ArraySeqMem<int>> seq(build(), ArraySeqMem<int>());
+    const auto& view = seq;
+    size_t index = 0;
+    for (int value : view.Elements(0, expected.size() + 10, 333)) {
+        int wanted = index < expected.size() ? expected[index] : 0;
+        if (value != wanted) return false;
+        index++;
+    }
+    if (index != expected.size() + 10) return false;
+
+    // Если все источники непрерывные, заполнение не материализуется
+    ConcatGenerator<int> contiguous;
+    contiguous.AddVector(std::vector<int>{1, 2, 3}).AddFile(file).SetFill(-5);
+    LazySeq<int, ConcatGenerator<int>, ArraySeqMem<int>> tape(std::move(contiguous), ArraySeqMem<int>());
+    if (std::as_const(tape).Get(1000000)->get() != -5 || tape.MaterializedCount() != 0) return false;
+    if (tape.ImplicitTailStart() != 3 + payload.size()) return false;
+
+    // Без заполнения последовательность конечна
+    ConcatGenerator<int> finite;
+    finite.AddVector(std::vector<int>{5, 6}).AddGenerator(std::make_unique<FunctionGenerator<int>>([]() -> int {
+        throw std::out_of_range("пусто");
+    }));
+    LazySeq<int, ConcatGenerator<int>, ArraySeqMem<int>> finite_seq(std::move(finite), ArraySeqMem<int>());
+    bool ok = finite_seq.Get(1) && finite_seq.Get(1)->get() == 6 && !finite_seq.Get(2) && finite_seq.MaterializedCount() == 2;
+
+    file.reset();
+    std::filesystem::remove(path);
+    return ok;
+}
+
+/**
+ * Тест сохранения и загрузки материализованного префикса LazySeq
+ */
+bool TestLazySeqPersistence() {
+    auto path = std::filesystem::temp_directory_path() / "lazyseq_persistence_test.bin";
+    auto simulate = [](size_t& calls) {
+        return FunctionGenerator<long long>([&calls]() {
+            long long value = static_cast<long long>(calls * calls % 9973);
+            calls++;
+            return value;
+        });
+    };
+
+    // Дорогой генератор материализует префикс один раз
+    size_t first_calls = 0;
+    LazySeq<long long, FunctionGenerator<long long>, ArraySeqMem<long long>> original(
+        simulate(first_calls), ArraySeqMem<long long>());
+    if (!original.Get(49999)) return false;
+    original.SaveMaterialized(path.string());
+
+    // Следующий запуск: префикс читается из файла, генератор не вызывается
+    size_t second_calls = 0;
+    LazySeq<long long, FunctionGenerator<long long>, MappedSeqMem<long long>> warm(
+        simulate(second_calls), MappedSeqMem<long long>::Load(path.string()));
+    if (warm.MaterializedCount() != 50000) return false;
+    for (size_t i = 0; i < 50000; i += 777) {
+        if (warm.Get(i)->get() != original.Get(i)->get()) return false;
+    }
+    if (second_calls != 0) return false;
+
+    // За префиксом генератор догоняет его и продолжает с правильного индекса
+    if (warm.Get(50010)->get() != original.Get(50010)->get()) return false;
+    if (second_calls != 50011) return false;
+
+    // Изменения префикса не попадают в файл, копия независима
+    warm.Get(5)->get() = -1;
+    auto copy = warm;
+    copy.Get(6)->get() = -2;
+    if (copy.Get(5)->get() != -1 || warm.Get(6)->get() != original.Get(6)->get()) return false;
+    auto reloaded = MappedSeqMem<long long>::Load(path.string());
+    if (reloaded.Get(5)->get() != original.Get(5)->get()) return false;
+
+    // Файл для элементов другого размера отвергается
+    bool rejected = false;
+    try {
+        MappedSeqMem<int>::Load(path.string());
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    std::filesystem::remove(path);
+    return rejected;
+}
+
+/**
+ * Тест лог-линейных гистограмм
+ */
+bool TestHdrHistogram() {
+    // Границы корзин: значение внутри своей корзины, ширина в пределах точности
+    HistogramLayout layout(7);
+    uint64_t seed = 12345;
+    for (int i = 0; i < 100000; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint64_t value = seed >> (seed % 64);
+        size_t index = layout.IndexOf(value);
+        if (index >= layout.GetBucketsCount()) return false;
+        uint64_t low = layout.LowestValue(index);
+        uint64_t high = layout.HighestValue(index);
+        if (value < low || value > high) return false;
+        if (high - low > (low >> 6)) return false;
+    }
+    if (layout.HighestValue(layout.IndexOf(~uint64_t{0})) != ~uint64_t{0}) return false;
+
+    // Перцентили с точностью до ширины корзины
+    HdrHistogram histogram(7);
+    std::vector<uint64_t> values;
+    for (uint64_t i = 1; i <= 100000; ++i) {
+        uint64_t value = i * i % 1000003;
+        values.push_back(value);
+        histogram.Record(value);
+    }
+    std::sort(values.begin(), values.end());
+    for (double percentile : {1.0, 50.0, 90.0, 99.0, 99.9, 100.0}) {
+        uint64_t exact = values[static_cast<size_t>(std::ceil(percentile / 100.0 * values.size())) - 1];
+        uint64_t estimate = histogram.GetValueAtPercentile(percentile);
+        if (estimate < exact || estimate > exact + (exact >> 6) + 1) return false;
+    }
+    if (histogram.GetMin() != values.front() || histogram.GetMax() != values.back()) return false;
+
+    // Сумма гистограмм частей совпадает с гистограммой целого
+    HdrHistogram left(7), right(7), whole(7);
+    for (uint64_t i = 0; i < 5000; ++i) {
+        (i % 3 ? left : right).Record(i * 37);
+        whole.Record(i * 37);
+    }
+    left.Merge(right);
+    for (double percentile : {10.0, 50.0, 99.0}) {
+        if (left.GetValueAtPercentile(percentile) != whole.GetValueAtPercentile(percentile)) return false;
+    }
+    if (left.GetTotalCount() != 5000 || left.GetMean() != whole.GetMean()) return false;
+
+    std::ostringstream csv;
+    whole.ExportCsv(csv);
+    if (csv.str().rfind("low,high,count,cumulative_percent", 0) != 0) return false;
+
+    // Запись из нескольких потоков
+    ConcurrentHistogram concurrent(7);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&concurrent, t]() {
+            auto& recorder = concurrent.AcquireRecorder();
+            for (uint64_t i = 0; i < 10000; ++i) recorder.Record(i + static_cast<uint64_t>(t) * 10000);
+        });
+    }
+    HdrHistogram partial = concurrent.Snapshot();   // Во время записи
+    for (auto& thread : threads) thread.join();
+    HdrHistogram total = concurrent.Snapshot();
+    return partial.GetTotalCount() <= 40000 && total.GetTotalCount() == 40000 &&
+           total.GetMin() == 0 && total.GetMax() == 39999 && total.GetMean() == 19999.5;
+}
+
+/**
+ * Тест трассировки интервалов в формате Chrome trace events
+ */
+bool TestTracer() {
+    Tracer& tracer = Tracer::Instance();
+    tracer.Clear();
+
+    auto make_job = [](int length) {
+        ScheduledJob<int, int> job;
+        job.machine = {0, 0, {{0, 1, 0, 1, Direction::RIGHT}, {0, 0, -1, 0, Direction::STAY}}, {-1}};
+        job.input.assign(static_cast<size_t>(length), 1);
+        return job;
+    };
+    std::vector<ScheduledJob<int, int>> jobs = {make_job(500), make_job(3000), make_job(10)};
+
+    // Выключенная трассировка ничего не пишет
+    ParallelBatchExecutor<int, int> executor(2, 1000, std::make_unique<PrioritySchedulingPolicy>());
+    executor.Run(jobs);
+    if (tracer.GetEventsCount() != 0) return false;
+
+    tracer.Enable();
+    auto reports = executor.Run(jobs);
+    {
+        TraceSpan span("test", "custom \"span\"");
+        span.SetArg("value", 42);
+    }
+    tracer.Disable();
+
+    std::ostringstream json;
+    tracer.WriteChromeTrace(json);
+    std::string text = json.str();
+    tracer.Clear();
+
+    auto count = [&text](const std::string& needle) {
+        size_t found = 0;
+        for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) found++;
+        return found;
+    };
+
+    // Кванты: 1 + 4 + 1; машина создаётся трижды и трижды запускается, остальное - продолжения
+    size_t slices = 0;
+    for (const auto& report : reports) slices += report.slices;
+    if (count("\"name\":\"slice\"") != slices || slices != 6) return false;
+    if (count("\"name\":\"compile\"") != 3 || count("\"name\":\"load input\"") != 3) return false;
+    if (count("\"name\":\"run\"") != 3 || count("\"name\":\"resume\"") != 3) return false;
+    if (count("\"name\":\"write result\"") != 3 || count("\"name\":\"requeue\"") != 3) return false;
+    if (count("\"thread_name\"") < 1) return false;
+    if (text.find("\"name\":\"custom \\\"span\\\"\",\"pid\":1") == std::string::npos) return false;
+    if (text.find("\"args\":{\"value\":42}") == std::string::npos) return false;
+    if (text.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) != 0) return false;
+    return count("{") == count("}") && count("[") == count("]");
+}
+
+/**
+ * Тест выборочного профилировщика состояний
+ */
+bool TestSamplingProfiler() {
+    SamplingProfiler& profiler = SamplingProfiler::Instance();
+    if (SamplingProfiler::IsEnabled()) return false;
+
+    const size_t max_steps = 200000;
+    auto run_machines = [max_steps](std::chrono::milliseconds duration) {
+        auto deadline = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < deadline) {
+            // Состояния 0 -> 1 -> 2 -> 0 по кругу, головка идёт вправо
+            TuringMachine<int, int> tm(0, 0);
+            tm.AddTransition(0, 0, 1, 1, Direction::RIGHT);
+            tm.AddTransition(1, 0, 2, 1, Direction::RIGHT);
+            tm.AddTransition(2, 0, 0, 1, Direction::RIGHT);
+            if (tm.Run(max_steps) != ExecutionResult::TIMEOUT) return false;
+        }
+        return true;
+    };
+
+    profiler.Start(1000);
+    if (!SamplingProfiler::IsEnabled() || !profiler.IsRunning()) return false;
+    bool started_twice = false;
+    try {
+        profiler.Start();
+    } catch (const std::logic_error&) {
+        started_twice = true;
+    }
+    bool completed = run_machines(std::chrono::milliseconds(300));
+    StateProfile profile = profiler.Stop();
+    if (!started_twice || !completed || SamplingProfiler::IsEnabled()) return false;
+
+    // Выборки есть, и все они - из состояний машины с головкой в пройденном отрезке
+    if (profile.GetTotalSamples() < 10 || profile.GetDroppedSamples() != 0) return false;
+    size_t samples = 0;
+    for (const auto& entry : profile.GetEntries()) {
+        if (entry.state_id > 2) return false;
+        if (entry.min_head < 0 || entry.max_head > static_cast<long long>(max_steps)) return false;
+        samples += entry.samples;
+    }
+    if (samples != profile.GetTotalSamples()) return false;
+    if (profile.GetEntries().front().samples < profile.GetEntries().back().samples) return false;
+
+    std::ostringstream report;
+    profile.Print(report);
+    if (report.str().find("Выборок: ") != 0) return false;
+
+    // Без профилировщика машины ничего не публикуют, повторная остановка - пустой профиль
+    return run_machines(std::chrono::milliseconds(10)) && profiler.Stop().GetTotalSamples() == 0;
+}
+
+/**
+ * Тест учёта ресурсов запуска: процессорное время, память, выделения
+ */
+bool TestResourceAccounting() {
+    if (!AllocationCounter::IsInstalled()) return false;
+
+    // Процессорное время не растёт, пока поток спит; чужие выделения не учитываются
+    StatisticsManager statistics;
+    statistics.StartExecution();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::thread other([]() {
+        std::vector<std::unique_ptr<int>> values;
+        for (int i = 0; i < 1000; ++i) values.push_back(std::make_unique<int>(i));
+    });
+    other.join();
+    statistics.EndExecution();
+    if (statistics.GetExecutionTimeMicros().count() < 50000) return false;
+    if (statistics.GetCpuTimeMicros().count() > 20000) return false;
+    if (statistics.GetAllocationsCount() > 10) return false;
+
+    // Машина пишет 100000 ячеек: лента растёт, каждая запись - узел в карте модификаций
+    TuringMachine<int, int> tm(0, 0);
+    tm.AddTransition(0, 0, 0, 1, Direction::RIGHT);
+    if (tm.Run(100000) != ExecutionResult::TIMEOUT) return false;
+    const StatisticsManager& run = tm.GetStatisticsManager();
+    if (run.GetCpuTimeMicros().count() <= 0) return false;
+    if (run.GetCpuTimeMicros().count() > run.GetExecutionTimeMicros().count() + 1000) return false;
+    if (run.GetPeakMemoryBytes() < 100000 * sizeof(int)) return false;
+    if (run.GetAllocationsCount() < 100000 || run.GetAllocatedBytes() < 100000 * sizeof(int)) return false;
+
+    std::ostringstream printed;
+    run.PrintStatistics(printed);
+    if (printed.str().find("Выделений памяти: ") == std::string::npos) return false;
+
+    // Пакетный исполнитель суммирует ресурсы квантов
+    std::vector<ScheduledJob<int, int>> jobs(2);
+    for (auto& job : jobs) {
+        job.machine = {0, 0, {{0, 0, 0, 1, Direction::RIGHT}}, {}};
+        job.max_steps = 20000;
+    }
+    ParallelBatchExecutor<int, int> executor(2, 5000, std::make_unique<PrioritySchedulingPolicy>());
+    auto reports = executor.Run(jobs);
+    double cpu_seconds = 0.0;
+    for (const auto& report : reports) {
+        if (report.slices != 4 || report.cpu_seconds <= 0.0) return false;
+        if (report.peak_memory_bytes < 20000 * sizeof(int) || report.allocations < 20000) return false;
+        cpu_seconds += report.cpu_seconds;
+    }
+    const auto& metrics = executor.GetMetrics();
+    return std::abs(metrics.cpu_seconds - cpu_seconds) < 1e-9 && metrics.allocations >= 40000 &&
+           metrics.peak_memory_bytes == std::max(reports[0].peak_memory_bytes, reports[1].peak_memory_bytes);
+}
+
+/**
+ * Тест временного ряда пропускной способности
+ */
+bool TestThroughputSeries() {
+    // По умолчанию ряд не ведётся
+    TuringMachine<int, int> plain(0, 0);
+    plain.AddTransition(0, 0, 0, 1, Direction::RIGHT);
+    plain.Run(50000);
+    if (!plain.GetStatisticsManager().GetThroughputSeries().empty()) return false;
+
+    TuringMachine<int, int> tm(0, 0);
+    tm.AddTransition(0, 0, 0, 1, Direction::RIGHT);
+    StatisticsManager& statistics = tm.GetStatisticsManager();
+    statistics.EnableThroughputSeries(10000, 8);
+    if (tm.Run(100000) != ExecutionResult::TIMEOUT) return false;
+
+    // 10 окон, в кольце последние 8
+    auto series = statistics.GetThroughputSeries();
+    if (series.size() != 8 || statistics.GetDroppedThroughputSamples() != 2) return false;
+    for (size_t i = 0; i < series.size(); ++i) {
+        if (series[i].step != 30000 + 10000 * i || series[i].steps_per_second <= 0.0) return false;
+        if (series[i].memory_bytes < series[i].step * sizeof(int)) return false;
+        if (i > 0 && (series[i].elapsed_seconds < series[i - 1].elapsed_seconds ||
+                      series[i].memory_bytes < series[i - 1].memory_bytes)) return false;
+    }
+    if (statistics.GetPeakMemoryBytes() < series.back().memory_bytes) return false;
+
+    // Resume продолжает ряд, время не сбрасывается
+    double before = series.back().elapsed_seconds;
+    if (tm.Resume(150000) != ExecutionResult::TIMEOUT) return false;
+    series = statistics.GetThroughputSeries();
+    if (series.back().step != 150000 || series.front().step != 80000) return false;
+    if (series.back().elapsed_seconds < before) return false;
+
+    std::ostringstream csv;
+    statistics.ExportThroughputCsv(csv);
+    std::string line;
+    size_t lines = 0;
+    std::istringstream rows(csv.str());
+    while (std::getline(rows, line)) lines++;
+    if (lines != 9 || csv.str().rfind("step,elapsed_seconds,steps_per_second,memory_bytes\n80000,", 0) != 0) return false;
+    if (csv.str().find("\n150000,") == std::string::npos) return false;
+
+    tm.Reset();
+    return statistics.GetThroughputSeries().empty() && statistics.GetThroughputWindow() == 10000;
+}
+
+/**
+ * Тест разбивки памяти машины
+ */
+bool TestMemoryFootprint() {
+    // Учёт аллокатора совпадает с фактическими выделениями
+    uint64_t before = AllocationCounter::GetThreadAllocatedBytes();
+    std::vector<int, TrackingAllocator<int>> values;
+    uint64_t tracker_overhead = AllocationCounter::GetThreadAllocatedBytes() - before;
+    values.reserve(100);
+    if (values.get_allocator().GetAllocatedBytes() != 100 * sizeof(int)) return false;
+    if (AllocationCounter::GetThreadAllocatedBytes() - before - tracker_overhead != 100 * sizeof(int)) return false;
+    values.assign(10, 7);
+
+    // Копия считается отдельно, перемещённый контейнер остаётся рабочим
+    auto copy = values;
+    if (copy.get_allocator().GetAllocatedBytes() != 10 * sizeof(int)) return false;
+    if (values.get_allocator().GetAllocatedBytes() != 100 * sizeof(int)) return false;
+    auto moved = std::move(values);
+    values.push_back(1);
+    if (moved.get_allocator().GetAllocatedBytes() != 100 * sizeof(int) + values.capacity() * sizeof(int)) return false;
+
+    // Машина со входом из 1000 единиц проходит вправо 5000 шагов, записывая двойки
+    std::vector<int> input(1000, 1);
+    TuringMachine<int, int> tm(0, 0, input);
+    tm.AddTransition(0, 1, 0, 2, Direction::RIGHT);
+    tm.AddTransition(0, 0, 0, 2, Direction::RIGHT);
+    tm.AddFinalState(1);
+    MemoryFootprint empty = tm.GetMemoryFootprint();
+    tm.Run(5000);
+    MemoryFootprint footprint = tm.GetMemoryFootprint();
+
+    if (footprint.tape_base != 1000 * sizeof(int)) return false;
+    if (footprint.memo != tm.GetStrip().GetMaterializedCount() * sizeof(int)) return false;
+    if (footprint.tape_overlay != tm.GetStrip().GetStorage().GetModifications().get_allocator().GetAllocatedBytes()) return false;
+    if (footprint.tape_overlay < 5000 * sizeof(std::pair<const int, int>)) return false;
+    if (footprint.rules != empty.rules || footprint.rules <= sizeof(TransitionManager<int, int>)) return false;
+    if (footprint.metadata < sizeof(tm) + sizeof(StatisticsManager)) return false;
+    if (footprint.GetTotal() != footprint.tape_base + footprint.tape_overlay + footprint.memo +
+                                footprint.rules + footprint.metadata) return false;
+    if (tm.GetStatisticsManager().GetPeakMemoryBytes() < footprint.tape_overlay) return false;
+
+    std::ostringstream statistics;
+    tm.PrintStatistics(statistics);
+    if (statistics.str().find("=== Память ===") == std::string::npos) return false;
+
+    // Блочное хранилище: ячейки лежат в блоках записей
+    TuringMachine<int, int, ChunkedTapeStorage<int, 64>> chunked(0, 0);
+    chunked.AddTransition(0, 0, 0, 2, Direction::RIGHT);
+    chunked.Run(1000);
+    MemoryFootprint blocks = chunked.GetMemoryFootprint();
+    return blocks.tape_base == 0 && blocks.memo == 0 &&
+           blocks.tape_overlay >= 16 * 64 * sizeof(int) && blocks.tape_overlay < 18 * 64 * sizeof(int) + 1024;
+}
+
+/**
+ * Тест статического анализа ловушек в графе состояний
+ */
+bool TestStateGraphAnalysis() {
+    // 3 идёт вправо по единицам и останавливается на двойке; на пустой ячейке
+    // уходит в цикл {0, 1}, где правила есть для всех символов
+    auto build = [](TuringMachine<int, int>& tm) {
+        tm.AddTransition(3, 1, 3, 1, Direction::RIGHT);
+        tm.AddTransition(3, 0, 0, 0, Direction::RIGHT);
+        for (int symbol = 0; symbol <= 2; ++symbol) {
+            tm.AddTransition(0, symbol, 1, symbol, Direction::RIGHT);
+            tm.AddTransition(1, symbol, 0, symbol, Direction::LEFT);
+        }
+        tm.AddFinalState(5);
+    };
+    std::vector<int> input(3000, 1);
+
+    TuringMachine<int, int> tm(3, 0, input);
+    build(tm);
+    const auto& analysis = tm.GetStateGraphAnalysis();
+    if (!analysis.IsTrap(0) || !analysis.IsTrap(1) || analysis.IsTrap(3) || analysis.IsTrap(5)) return false;
+    if (analysis.CanReachFinal(3) || !analysis.CanReachFinal(5) || !analysis.CanHalt(3)) return false;
+    if (analysis.GetComponent(0) != analysis.GetComponent(1) || analysis.GetComponent(0) == analysis.GetComponent(3)) return false;
+    if (!analysis.IsBottomComponent(analysis.GetComponent(0)) || analysis.IsBottomComponent(analysis.GetComponent(3))) return false;
+    if (analysis.GetComponentsCount() != 3 || analysis.GetStatesCount() != 4) return false;
+
+    // Без анализа машина тратит весь бюджет
+    if (tm.Run(100000) != ExecutionResult::TIMEOUT || tm.GetStepCount() != 100000) return false;
+
+    // С анализом останавливается на шаге входа в ловушку (шаг 3001)
+    tm.Reset(input);
+    tm.EnableTrapDetection();
+    if (tm.Run(100000) != ExecutionResult::NON_HALTING) return false;
+    if (tm.GetStepCount() != 3001 || tm.GetCurrentState() != 0) return false;
+
+    // Двойка на входе: 3 останавливается на ней, ловушка не наступает
+    std::vector<int> stopped = input;
+    stopped.push_back(2);
+    tm.Reset(stopped);
+    if (tm.Run(100000) != ExecutionResult::REJECTED || tm.GetStepCount() != 3000) return false;
+
+    // Машина, запущенная прямо в ловушке, останавливается сразу
+    TuringMachine<int, int> trapped(0, 0);
+    build(trapped);
+    trapped.EnableTrapDetection();
+    if (trapped.Run(100000) != ExecutionResult::NON_HALTING || trapped.GetStepCount() != 0) return false;
+
+    // Новое конечное состояние в цикле сбрасывает анализ: ловушки больше нет
+    trapped.AddFinalState(1);
+    if (trapped.GetStateGraphAnalysis().IsTrap(0) || !trapped.GetStateGraphAnalysis().CanReachFinal(0)) return false;
+    trapped.Reset();
+    if (trapped.Run(100000) != ExecutionResult::ACCEPTED || trapped.GetStepCount() != 1) return false;
+    if (!tm.GetStateGraphAnalysis().HasTraps() || trapped.GetStateGraphAnalysis().HasTraps()) return false;
+
+    // Символ, записанный на ленту в обход правил, сбрасывает анализ:
+    // для двойки у 0 нет правила, так что ловушки больше нет
+    TuringMachine<int, int> looping(0, 0);
+    looping.AddTransition(0, 0, 0, 0, Direction::STAY);
+    looping.AddTransition(0, 1, 0, 1, Direction::STAY);
+    looping.EnableTrapDetection();
+    if (looping.Run(5000) != ExecutionResult::NON_HALTING) return false;
+    looping.SetSymbolAt(0, 2);
+    if (looping.Run(5000) != ExecutionResult::REJECTED || looping.GetStepCount() != 0) return false;
+    looping.Reset();
+    looping.GetStrip().SetSymbolAt(0, 2);
+    return looping.Run(5000) == ExecutionResult::REJECTED;
+}
+
+/**
+ * Тест JIT-движка: результат совпадает с интерпретатором (и с TuringMachine::Run)
+ */
+bool TestJitEngine() {
+    InterpreterEngine<int, int> interpreter;
+    JitEngine<int, int> jit;
+    std::atomic<bool> no_cancel{false};
+
+    // Все машины 2x2 на нескольких входах и лимитах
+    MachineEnumerator enumerator(2, 2);
+    bool agree = true;
+    enumerator.Enumerate([&](const MachineEnumerator::Table& table) {
+        TransitionManager<int, int> rules;
+        enumerator.ToTransitionManager(table, rules);
+        MachineDefinition<int, int> definition{0, 0, rules.GetAllRules(), {1}};
+        JitProgram<int, int> program(definition);
+        agree = agree && program.IsCompiled() == JitEngine<int, int>::IsAvailable();
+        for (const auto& tape : std::vector<std::vector<int>>{{}, {1, 1, 0, 1}, {1, 7, 1}}) {
+            for (size_t max_steps : {0, 1, 5, 50}) {
+                auto expected = interpreter.Execute(definition, tape, max_steps, no_cancel);
+                agree = agree && expected.SameAs(jit.Execute(program, tape, max_steps, no_cancel));
+            }
+        }
+    });
+    if (!agree) return false;
+
+    // Бег влево и вправо далеко за начальный буфер ленты
+    for (Direction direction : {Direction::LEFT, Direction::RIGHT}) {
+        MachineDefinition<int, int> runaway{0, 0, {}, {}};
+        runaway.rules.emplace_back(0, 0, 0, 1, direction);
+        auto expected = interpreter.Execute(runaway, {}, 100000, no_cancel);
+        auto actual = jit.Execute(runaway, {}, 100000, no_cancel);
+        if (!expected.SameAs(actual) || actual.tape.size() != 100001) return false;
+    }
+
+    // Зигзаг между растущими краями: буфер ленты растёт в обе стороны,
+    // срезы бюджета заканчиваются посреди прохода
+    MachineDefinition<std::string, char> zigzag{"R", '_', {}, {"STOP"}};
+    zigzag.rules.emplace_back("R", '1', "R", '1', Direction::RIGHT);
+    zigzag.rules.emplace_back("R", '_', "L", '1', Direction::LEFT);
+    zigzag.rules.emplace_back("L", '1', "L", '1', Direction::LEFT);
+    zigzag.rules.emplace_back("L", '_', "R", '1', Direction::RIGHT);
+    zigzag.rules.emplace_back("R", 'x', "STOP", 'y', Direction::STAY);
+    InterpreterEngine<std::string, char> char_interpreter;
+    JitEngine<std::string, char> char_jit;
+    for (size_t max_steps : {4095, 4096, 4097, 300000}) {
+        auto expected = char_interpreter.Execute(zigzag, {}, max_steps, no_cancel);
+        auto actual = char_jit.Execute(zigzag, {}, max_steps, no_cancel);
+        if (!expected.SameAs(actual) || actual.result != ExecutionResult::TIMEOUT) return false;
+    }
+
+    // Символ входа вне правил остаётся на ленте и останавливает машину;
+    // 'x' справа ведёт в конечное состояние
+    std::vector<char> input(300, '_');
+    input.push_back('?');
+    input.push_back('1');
+    auto expected = char_interpreter.Execute(zigzag, input, 1000000, no_cancel);
+    auto actual = char_jit.Execute(zigzag, input, 1000000, no_cancel);
+    if (!expected.SameAs(actual) || actual.result != ExecutionResult::REJECTED) return false;
+    input[300] = 'x';
+    expected = char_interpreter.Execute(zigzag, input, 1000000, no_cancel);
+    actual = char_jit.Execute(zigzag, input, 1000000, no_cancel);
+    if (!expected.SameAs(actual) || actual.result != ExecutionResult::ACCEPTED) return false;
+
+    // Совпадение с Run на длинном входе
+    TuringMachine<std::string, char> tm("R", '_', input);
+    for (const auto& rule : zigzag.rules) {
+        tm.AddTransition(rule.from_state, rule.read_symbol, rule.to_state, rule.write_symbol, rule.direction);
+    }
+    tm.AddFinalState("STOP");
+    if (tm.Run(1000000) != actual.result || tm.GetStepCount() != actual.steps) return false;
+    if (tm.GetCurrentState() != actual.final_state || tm.GetHeadPosition() != actual.head_position) return false;
+    if (tm.GetTapeSegment(actual.tape_start, actual.tape.size()) != actual.tape) return false;
+
+    // Отмена прерывает исполнение
+    std::atomic<bool> cancel{true};
+    return char_jit.Execute(zigzag, {}, 1000000, cancel).cancelled;
+}
+
+/**
+ * Нагрузочный тест очереди: несколько производителей и потребителей,
+ * маленькая ёмкость, обратное давление и закрытие
+ */
+bool TestMPMCQueueStress() {
+    const size_t PRODUCERS = 4;
+    const size_t CONSUMERS = 4;
+    const size_t PER_PRODUCER = 50000;
+    BoundedMPMCQueue<std::pair<size_t, size_t>> queue(8);   // (производитель, номер)
+
+    std::vector<std::vector<std::pair<size_t, size_t>>> received(CONSUMERS);
+    std::vector<std::thread> consumers;
+    for (size_t c = 0; c < CONSUMERS; ++c) {
+        consumers.emplace_back([&queue, &received, c]() {
+            std::pair<size_t, size_t> item;
+            while (queue.Pop(item)) {
+                received[c].push_back(item);
+            }
+        });
+    }
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&queue, p]() {
+            for (size_t i = 0; i < PER_PRODUCER; ++i) {
+                queue.Push({p, i});
+            }
+        });
+    }
+    for (auto& producer : producers) producer.join();
+    queue.Close();
+    for (auto& consumer : consumers) consumer.join();
+
+    // Каждый элемент получен ровно один раз; элементы одного производителя
+    // приходят к каждому потребителю в порядке добавления
+    std::vector<std::vector<bool>> seen(PRODUCERS, std::vector<bool>(PER_PRODUCER, false));
+    size_t total = 0;
+    for (const auto& items : received) {
+        std::vector<long long> last(PRODUCERS, -1);
+        for (const auto& [producer, index] : items) {
+            if (seen[producer][index]) return false;
+            seen[producer][index] = true;
+            if (static_cast<long long>(index) <= last[producer]) return false;
+            last[producer] = static_cast<long long>(index);
+        }
+        total += items.size();
+    }
+    if (total != PRODUCERS * PER_PRODUCER || queue.ApproxSize() != 0) return false;
+
+    // Закрытая очередь отклоняет Push, Pop дочитывает остаток
+    BoundedMPMCQueue<int> closing(4);
+    if (!closing.Push(1) || !closing.TryPush(2)) return false;
+    closing.Close();
+    int value = 0;
+    if (closing.Push(3) || !closing.IsClosed()) return false;
+    if (!closing.Pop(value) || value != 1 || !closing.Pop(value) || value != 2) return false;
+    return !closing.Pop(value);
+}
+
+/**
+ * Тест потокового исполнителя: несколько производителей заданий и потребителей результатов
+ */
+bool TestStreamingBatchRunner() {
+    // Проход вправо по единицам: n единиц - n + 1 шаг
+    MachineDefinition<int, int> scanner{0, 0, {}, {1}};
+    scanner.rules.emplace_back(0, 1, 0, 1, Direction::RIGHT);
+    scanner.rules.emplace_back(0, 0, 1, 0, Direction::STAY);
+
+    const size_t PRODUCERS = 3;
+    const size_t PER_PRODUCER = 200;
+    std::vector<size_t> steps(PRODUCERS * PER_PRODUCER, 0);
+    std::atomic<size_t> mismatches{0};
+    {
+        StreamingBatchRunner<int, int> runner(2, 4);
+        std::vector<std::thread> consumers;
+        for (int c = 0; c < 2; ++c) {
+            consumers.emplace_back([&]() {
+                StreamingBatchRunner<int, int>::Result result;
+                while (runner.Next(result)) {
+                    steps[result.id] = result.outcome.steps;
+                    if (result.outcome.result != ExecutionResult::ACCEPTED) mismatches++;
+                }
+            });
+        }
+        std::vector<std::thread> producers;
+        for (size_t p = 0; p < PRODUCERS; ++p) {
+            producers.emplace_back([&, p]() {
+                for (size_t i = 0; i < PER_PRODUCER; ++i) {
+                    size_t id = p * PER_PRODUCER + i;
+                    runner.Submit({id, scanner, std::vector<int>(id % 97, 1), 1000});
+                }
+            });
+        }
+        for (auto& producer : producers) producer.join();
+        runner.CloseIntake();
+        for (auto& consumer : consumers) consumer.join();
+        if (runner.Submit({0, scanner, {}, 10})) return false;
+    }
+    if (mismatches != 0) return false;
+    for (size_t id = 0; id < steps.size(); ++id) {
+        if (steps[id] != id % 97 + 1) return false;
+    }
+
+    // Рабочий поток занят бесконечной машиной: очередь приёма заполняется,
+    // Submit ждёт, пока приём не закроют; разрушение отменяет задание
+    MachineDefinition<int, int> runaway{0, 0, {}, {}};
+    runaway.rules.emplace_back(0, 0, 0, 1, Direction::RIGHT);
+    StreamingBatchRunner<int, int> stalled(1, 2);
+    std::atomic<size_t> accepted{0};
+    std::thread producer([&]() {
+        for (size_t id = 0; id < 10; ++id) {
+            if (stalled.Submit({id, runaway, {}, std::numeric_limits<size_t>::max()})) accepted++;
+        }
+    });
+    for (int wait = 0; wait < 10000 && stalled.GetBlockedSubmits() == 0; ++wait) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    bool blocked = stalled.GetBlockedSubmits() > 0;
+    stalled.CloseIntake();
+    producer.join();
+    return blocked && accepted >= 2 && accepted < 10;
+}
+
+/**
+ * Тест перебора недетерминированной машины: поиск в ширину и параллельный
+ * поиск в глубину с итеративным углублением дают одинаковый вердикт
+ */
+bool TestNondeterministicExploration() {
+    // Угадать место подстроки "11": в состоянии 0 на '1' можно идти дальше или проверить
+    TuringMachine<int, char> guesser(0, '_');
+    guesser.AddTransition(0, '0', 0, '0', Direction::RIGHT);
+    guesser.AddNondeterministicTransition(0, '1', 0, '1', Direction::RIGHT);
+    guesser.AddNondeterministicTransition(0, '1', 1, '1', Direction::RIGHT);
+    guesser.AddNondeterministicTransition(0, '1', 1, '1', Direction::RIGHT);   // Повтор не добавляется
+    guesser.AddTransition(1, '1', 2, '1', Direction::STAY);
+    guesser.AddFinalState(2);
+
+    const auto& transitions = guesser.GetTransitionManager();
+    if (transitions.IsDeterministic() || transitions.FindRules(0, '1').size() != 2) return false;
+    if (transitions.FindRules(0, '1')[0].to_state != 0 || transitions.GetAllChoices().size() != 4) return false;
+
+    // Ветвь должна исполняться по правилам машины и прийти в конечное состояние
+    auto replays = [](const std::vector<TransitionRule<int, char>>& path, const std::vector<char>& input,
+                      int final_state) {
+        std::map<long long, char> tape;
+        for (size_t i = 0; i < input.size(); ++i) tape[static_cast<long long>(i)] = input[i];
+        int state = 0;
+        long long head = 0;
+        for (const auto& rule : path) {
+            char symbol = tape.count(head) ? tape[head] : '_';
+            if (rule.from_state != state || rule.read_symbol != symbol) return false;
+            tape[head] = rule.write_symbol;
+            head += static_cast<int>(rule.direction);
+            state = rule.to_state;
+        }
+        return state == final_state;
+    };
+
+    auto explorer = NondeterministicExplorer<int, char>::FromMachine(guesser);
+    ExplorationOptions bfs;
+    bfs.mode = ExplorationMode::BREADTH_FIRST;
+    ExplorationOptions dfs;
+    dfs.threads = 4;
+    dfs.initial_depth = 2;
+    dfs.transposition_entries = 1 << 12;
+
+    std::vector<char> accepted = {'0', '1', '0', '1', '1', '0'};
+    std::vector<char> rejected = {'0', '1', '0', '1', '0', '0', '1'};
+    for (const auto& options : {bfs, dfs}) {
+        auto yes = explorer.Explore(accepted, options);
+        if (yes.verdict != ExplorationVerdict::ACCEPTED || !replays(yes.path, accepted, 2)) return false;
+        if (explorer.Explore(rejected, options).verdict != ExplorationVerdict::REJECTED) return false;
+    }
+    if (explorer.Explore(accepted, bfs).path.size() != 5) return false;   // Кратчайшая ветвь
+
+    // Детерминированный Run идёт по первому варианту и проходит мимо "11"
+    if (guesser.Run(100) != ExecutionResult::REJECTED) return false;
+
+    // Цикл конфигураций без конечных состояний: перебор завершается отказом
+    TransitionManager<int, char> cycle;
+    cycle.AddNondeterministicRule(0, '_', 1, '_', Direction::RIGHT);
+    cycle.AddNondeterministicRule(0, '_', 3, 'y', Direction::STAY);
+    cycle.AddRule(1, '_', 0, '_', Direction::LEFT);
+    NondeterministicExplorer<int, char> looping(cycle, 0, '_', {2});
+    if (looping.Explore({}, bfs).verdict != ExplorationVerdict::REJECTED) return false;
+    if (looping.Explore({}, dfs).verdict != ExplorationVerdict::REJECTED) return false;
+
+    // Случайное блуждание до метки 'G' в позиции 12: бесконечное число
+    // конфигураций, ответ зависит от предела глубины
+    TransitionManager<int, char> walk;
+    walk.AddNondeterministicRule(0, '_', 0, '_', Direction::LEFT);
+    walk.AddNondeterministicRule(0, '_', 0, '_', Direction::RIGHT);
+    walk.AddRule(0, 'G', 1, 'G', Direction::STAY);
+    NondeterministicExplorer<int, char> walker(walk, 0, '_', {1});
+    std::vector<char> track(12, '_');
+    track.push_back('G');
+    for (auto options : {bfs, dfs}) {
+        options.max_depth = 11;
+        if (walker.Explore(track, options).verdict != ExplorationVerdict::DEPTH_LIMIT) return false;
+        options.max_depth = 1000;
+        auto found = walker.Explore(track, options);
+        if (found.verdict != ExplorationVerdict::ACCEPTED || !replays(found.path, track, 1)) return false;
+        if (found.path.size() < 12 || found.path.size() > 1000) return false;
+    }
+
+    // Угадывание слова: 2^глубина ветвей. Фронт BFS растёт экспоненциально,
+    // поиск в глубину обходит то же дерево с таблицей из 4096 ячеек
+    TransitionManager<int, char> writer;
+    writer.AddNondeterministicRule(0, '_', 0, 'a', Direction::RIGHT);
+    writer.AddNondeterministicRule(0, '_', 0, 'b', Direction::RIGHT);
+    NondeterministicExplorer<int, char> words(writer, 0, '_', {1});
+    bfs.max_depth = dfs.max_depth = 14;
+    auto wide = words.Explore({}, bfs);
+    auto deep = words.Explore({}, dfs);
+    if (wide.verdict != ExplorationVerdict::DEPTH_LIMIT || wide.peak_frontier != (1u << 14)) return false;
+    return deep.verdict == ExplorationVerdict::DEPTH_LIMIT && deep.explored >= (1u << 15) - 1;
+}
+
+/**
+ * Тест gap buffer на нетривиально копируемых символах: перенос разрыва
+ * при заполненном буфере не должен терять ячейки
+ */
+bool TestGapBufferStringSymbols() {
+    GapBufferTapeStorage<std::string> storage("");
+    std::vector<std::string> expected;
+    for (int i = 0; i < 100000; ++i) {
+        expected.push_back("cell" + std::to_string(i));
+        storage.Set(i, expected.back());
+    }
+    for (int position : {5, 100, 3}) {
+        expected[static_cast<size_t>(position)] = "moved" + std::to_string(position);
+        storage.Set(position, expected[static_cast<size_t>(position)]);
+    }
+    for (int i = 0; i < 100000; ++i) {
+        if (storage.Get(i) != expected[static_cast<size_t>(i)]) return false;
+    }
+    
+    // Запись в начало и конец при каждом заполнении буфера
+    GapBufferTapeStorage<std::string> sides("_", {"x", "y"});
+    for (int i = 1; i <= 300; ++i) {
+        sides.Set(-i, "L" + std::to_string(i));
+        sides.Set(1 + i, "R" + std::to_string(i));
+    }
+    for (int i = 1; i <= 300; ++i) {
+        if (sides.Get(-i) != "L" + std::to_string(i) || sides.Get(1 + i) != "R" + std::to_string(i)) return false;
+    }
+    return sides.Get(0) == "x" && sides.Get(1) == "y" && sides.Get(302) == "_";
+}
+
 /**
  * Основная функция для запуска всех тестов
  */
@@ -370,6 +1806,33 @@ int main() {
     TestFramework::RunTest("📥 Сегменты ленты", TestTapeSegments);
     TestFramework::RunTest("➩ Отрицательные позиции", TestNegativePositions);
     TestFramework::RunTest("📊 Статистика выполнения", TestExecutionStatistics);
+    TestFramework::RunTest("♾️ Неявный пустой хвост ленты", TestImplicitBlankTail);
+    TestFramework::RunTest("🪞 Канонизация симметричных машин", TestSymmetryCanonicalization);
+    TestFramework::RunTest("🏭 Конвейер децайдеров", TestDeciderPipeline);
+    TestFramework::RunTest("⏪ Обратный анализ незавершаемости", TestBackwardReasoning);
+    TestFramework::RunTest("⚙️ Согласованность движков исполнения", TestExecutionEnginesAgree);
+    TestFramework::RunTest("🏁 Портфельный запуск", TestPortfolioRunner);
+    TestFramework::RunTest("📈 Эскалация лимита шагов", TestStepEscalation);
+    TestFramework::RunTest("🗓️ Политики планирования пакета", TestBatchScheduling);
+    TestFramework::RunTest("🧱 Хранилища ленты", TestTapeStorageBackends);
+    TestFramework::RunTest("🗜️ Компактное кодирование ленты", TestTapeCodec);
+    TestFramework::RunTest("🧬 Дедупликация блоков ленты", TestDedupTapeStorage);
+    TestFramework::RunTest("🧵 Обход LazySeq участками", TestLazySeqSpans);
+    TestFramework::RunTest("🔀 Параллельные свёртки по ленте", TestParallelReduce);
+    TestFramework::RunTest("🔗 Склейка источников генератора", TestConcatGenerator);
+    TestFramework::RunTest("💾 Сохранение префикса LazySeq", TestLazySeqPersistence);
+    TestFramework::RunTest("📊 Гистограммы задержек", TestHdrHistogram);
+    TestFramework::RunTest("🕸️ Трассировка интервалов", TestTracer);
+    TestFramework::RunTest("🔥 Выборочное профилирование состояний", TestSamplingProfiler);
+    TestFramework::RunTest("🧾 Учёт ресурсов запуска", TestResourceAccounting);
+    TestFramework::RunTest("📈 Временной ряд пропускной способности", TestThroughputSeries);
+    TestFramework::RunTest("🧮 Разбивка памяти машины", TestMemoryFootprint);
+    TestFramework::RunTest("🕳️ Анализ ловушек в графе состояний", TestStateGraphAnalysis);
+    TestFramework::RunTest("🚀 JIT-компиляция в машинный код x86-64", TestJitEngine);
+    TestFramework::RunTest("🚦 Нагрузка на lock-free очередь MPMC", TestMPMCQueueStress);
+    TestFramework::RunTest("🌊 Потоковое исполнение с обратным давлением", TestStreamingBatchRunner);
+    TestFramework::RunTest("🌳 Перебор ветвей недетерминированной машины", TestNondeterministicExploration);
+    TestFramework::RunTest("🧵 Gap buffer со строковыми символами", TestGapBufferStringSymbols);
     
     TestFramework::PrintSummary();
     